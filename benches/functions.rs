@@ -0,0 +1,247 @@
+use criterion::{
+    criterion_group, criterion_main, measurement::Measurement, BatchSize, BenchmarkGroup,
+    BenchmarkId, Criterion, Throughput,
+};
+use fast_fp::{ff32, ff64, FF32, FF64};
+use rand::{
+    distributions::{self, Distribution},
+    rngs::StdRng,
+    Rng, SeedableRng,
+};
+
+// large enough to measure in elements/sec, small enough to stay cache resident so the math
+// dominates instead of memory
+const N: usize = 1024;
+
+fn map_bench<T, S>(
+    group: &mut BenchmarkGroup<'_, impl Measurement>,
+    id: &str,
+    op: impl Fn(T) -> T + Copy,
+    mut rng: impl Rng,
+    vals: impl Distribution<S> + Copy,
+) where
+    T: From<S> + Copy,
+{
+    group.throughput(Throughput::Elements(N as u64));
+
+    group.bench_function(BenchmarkId::new(id, N), |b| {
+        b.iter_batched_ref(
+            || {
+                (&mut rng)
+                    .sample_iter(&vals)
+                    .take(N)
+                    .map(T::from)
+                    .collect::<Vec<T>>()
+            },
+            |vals| vals.iter_mut().for_each(|v| *v = op(*v)),
+            BatchSize::SmallInput,
+        );
+    });
+}
+
+fn zip_bench<T, S>(
+    group: &mut BenchmarkGroup<'_, impl Measurement>,
+    id: &str,
+    op: impl Fn(T, T) -> T + Copy,
+    mut rng: impl Rng,
+    vals: impl Distribution<S> + Copy,
+) where
+    T: From<S> + Copy,
+{
+    group.throughput(Throughput::Elements(N as u64));
+
+    group.bench_function(BenchmarkId::new(id, N), |b| {
+        b.iter_batched_ref(
+            || {
+                let gen = |rng: &mut dyn Iterator<Item = S>| {
+                    rng.take(N).map(T::from).collect::<Vec<T>>()
+                };
+                let mut sampler = (&mut rng).sample_iter(&vals);
+                (gen(&mut sampler), gen(&mut sampler))
+            },
+            |(a, b)| {
+                a.iter_mut()
+                    .zip(b.iter().copied())
+                    .for_each(|(a, b)| *a = op(*a, b))
+            },
+            BatchSize::SmallInput,
+        );
+    });
+}
+
+// one group per function, comparing the primitive against the fast type over the same values
+macro_rules! unary_groups {
+    ($c:expr, $rng:expr; $($fn:ident in ($lo:expr, $hi:expr);)*) => {
+        $({
+            let mut group = $c.benchmark_group(stringify!($fn));
+            let f32s = distributions::Uniform::<f32>::new($lo as f32, $hi as f32);
+            let f64s = distributions::Uniform::<f64>::new($lo, $hi);
+
+            map_bench(&mut group, "f32", f32::$fn, $rng.clone(), f32s);
+            map_bench(&mut group, "FF32", FF32::$fn, $rng.clone(), f32s);
+            map_bench(&mut group, "f64", f64::$fn, $rng.clone(), f64s);
+            map_bench(&mut group, "FF64", FF64::$fn, $rng.clone(), f64s);
+        })*
+    };
+}
+
+fn unary_fns(c: &mut Criterion) {
+    let rng = StdRng::from_entropy();
+
+    unary_groups! {
+        c, rng;
+        abs in (-1.0, 1.0);
+        ceil in (-100.0, 100.0);
+        floor in (-100.0, 100.0);
+        round in (-100.0, 100.0);
+        sqrt in (0.0, 100.0);
+        cbrt in (-100.0, 100.0);
+        exp in (-5.0, 5.0);
+        exp2 in (-5.0, 5.0);
+        ln in (0.1, 100.0);
+        log2 in (0.1, 100.0);
+        log10 in (0.1, 100.0);
+        sin in (-3.0, 3.0);
+        cos in (-3.0, 3.0);
+        tan in (-1.0, 1.0);
+        tanh in (-3.0, 3.0);
+        recip in (0.9, 1.1);
+    }
+}
+
+fn binary_fns(c: &mut Criterion) {
+    let rng = StdRng::from_entropy();
+
+    macro_rules! binary_groups {
+        ($($fn:ident in ($lo:expr, $hi:expr);)*) => {
+            $({
+                let mut group = c.benchmark_group(stringify!($fn));
+                let f32s = distributions::Uniform::<f32>::new($lo as f32, $hi as f32);
+                let f64s = distributions::Uniform::<f64>::new($lo, $hi);
+
+                zip_bench(&mut group, "f32", f32::$fn, rng.clone(), f32s);
+                zip_bench(&mut group, "FF32", FF32::$fn, rng.clone(), f32s);
+                zip_bench(&mut group, "f64", f64::$fn, rng.clone(), f64s);
+                zip_bench(&mut group, "FF64", FF64::$fn, rng.clone(), f64s);
+            })*
+        };
+    }
+
+    binary_groups! {
+        powf in (0.5, 2.0);
+        atan2 in (-1.0, 1.0);
+        copysign in (-1.0, 1.0);
+        max in (0.0, 1.0);
+        min in (0.0, 1.0);
+    }
+}
+
+fn clamp(c: &mut Criterion) {
+    let mut group = c.benchmark_group("clamp");
+
+    let rng = StdRng::from_entropy();
+    let f32s = distributions::Uniform::<f32>::new(-1.0, 2.0);
+
+    // the checked clamp asserts min <= max, which freezes both bounds per call; the
+    // unchecked variant is just the select kernel. Benching all three shows the assert cost
+    map_bench(&mut group, "f32", |v: f32| v.clamp(0.0, 1.0), rng.clone(), f32s);
+    map_bench(
+        &mut group,
+        "FF32",
+        |v: FF32| v.clamp(ff32(0.0), ff32(1.0)),
+        rng.clone(),
+        f32s,
+    );
+    map_bench(
+        &mut group,
+        "FF32_unchecked",
+        |v: FF32| v.clamp_unchecked(ff32(0.0), ff32(1.0)),
+        rng.clone(),
+        f32s,
+    );
+}
+
+fn freeze_overhead(c: &mut Criterion) {
+    let mut group = c.benchmark_group("freeze_overhead");
+
+    let rng = StdRng::from_entropy();
+    let f32s = distributions::Uniform::<f32>::new(0.0, 1.0);
+    let f64s = distributions::Uniform::<f64>::new(0.0, 1.0);
+
+    // the same multiply-add with and without an interposed comparison: each comparison on the
+    // fast types freezes both operands, so the delta between the pairs is the freeze cost
+    fn plain<T: Copy + std::ops::Add<Output = T> + std::ops::Mul<Output = T>>(a: T, b: T) -> T {
+        a * b + b
+    }
+
+    macro_rules! with_cmp {
+        ($zero:expr) => {
+            move |a, b| {
+                let r = plain(a, b);
+                if r > $zero {
+                    r
+                } else {
+                    $zero
+                }
+            }
+        };
+    }
+
+    zip_bench(&mut group, "f32_plain", plain::<f32>, rng.clone(), f32s);
+    zip_bench(&mut group, "f32_with_cmp", with_cmp!(0.0f32), rng.clone(), f32s);
+    zip_bench(&mut group, "FF32_plain", plain::<FF32>, rng.clone(), f32s);
+    zip_bench(&mut group, "FF32_with_cmp", with_cmp!(ff32(0.0)), rng.clone(), f32s);
+    zip_bench(&mut group, "f64_plain", plain::<f64>, rng.clone(), f64s);
+    zip_bench(&mut group, "f64_with_cmp", with_cmp!(0.0f64), rng.clone(), f64s);
+    zip_bench(&mut group, "FF64_plain", plain::<FF64>, rng.clone(), f64s);
+    zip_bench(&mut group, "FF64_with_cmp", with_cmp!(ff64(0.0)), rng.clone(), f64s);
+}
+
+fn sort(c: &mut Criterion) {
+    let mut group = c.benchmark_group("sort");
+
+    let mut rng = StdRng::from_entropy();
+    let f32s = distributions::Uniform::<f32>::new(0.0, 1.0);
+
+    for count in [1024usize, 16384] {
+        group.throughput(Throughput::Elements(count as u64));
+
+        let values: Vec<f32> = (&mut rng).sample_iter(&f32s).take(count).collect();
+
+        group.bench_function(BenchmarkId::new("f32", count), |b| {
+            b.iter_batched_ref(
+                || values.clone(),
+                |vals| vals.sort_unstable_by(|a, b| a.partial_cmp(b).unwrap()),
+                BatchSize::SmallInput,
+            );
+        });
+
+        // per-comparison freezing through PartialOrd, the slow path this crate warns about
+        group.bench_function(BenchmarkId::new("FF32_partial_cmp", count), |b| {
+            b.iter_batched_ref(
+                || values.iter().copied().map(ff32).collect::<Vec<FF32>>(),
+                |vals| vals.sort_unstable_by(|a, b| a.partial_cmp(b).unwrap()),
+                BatchSize::SmallInput,
+            );
+        });
+
+        // freeze-once batch sort
+        group.bench_function(BenchmarkId::new("FF32_slice_sort", count), |b| {
+            b.iter_batched_ref(
+                || values.iter().copied().map(ff32).collect::<Vec<FF32>>(),
+                |vals| fast_fp::slice::sort_unstable(vals),
+                BatchSize::SmallInput,
+            );
+        });
+    }
+}
+
+criterion_group!(
+    benches,
+    unary_fns,
+    binary_fns,
+    clamp,
+    freeze_overhead,
+    sort
+);
+criterion_main!(benches);
@@ -1,4 +1,12 @@
 fn main() {
+    // the fallback backend replaces the kernel libraries with pure-rust implementations, so
+    // there is nothing to compile and no LTO configuration to check
+    if std::env::var_os("CARGO_FEATURE_FALLBACK").is_some() {
+        return;
+    }
+
+    warn_if_no_cross_lang_lto();
+
     let mut builder = cc::Build::new();
 
     if !builder.get_compiler().is_like_clang() {
@@ -13,6 +21,24 @@ fn main() {
     build_c(builder);
 }
 
+fn warn_if_no_cross_lang_lto() {
+    // without -Clinker-plugin-lto the kernels cannot inline into rust code and every
+    // arithmetic op pays a real function call -- easily an order of magnitude slower, and
+    // easy to miss when a build environment is misconfigured. The rustc flags reach build
+    // scripts through this environment variable (0x1f-separated)
+    let flags = std::env::var("CARGO_ENCODED_RUSTFLAGS")
+        .or_else(|_| std::env::var("RUSTFLAGS"))
+        .unwrap_or_default();
+    if !flags.contains("linker-plugin-lto") {
+        println!(
+            "cargo:warning=fast_fp: -Clinker-plugin-lto was not detected in the rustc flags. \
+             Without cross-language LTO every operation is an FFI call; configure it as \
+             described in the README, or enable the `fallback` feature to use the pure-rust \
+             backend"
+        );
+    }
+}
+
 fn build_ll(mut builder: cc::Build) {
     // the ll files are written bare, let the compiler override module annotations and don't warn
     // about it
@@ -24,7 +50,18 @@ fn build_ll(mut builder: cc::Build) {
 fn build_c(mut builder: cc::Build) {
     builder.opt_level(3);
 
-    // TODO control flags with generics
+    // the reassociation-only policy types (AF32/AF64) get exactly that relaxation: clang
+    // ignores -fassociative-math without the signed-zero and trapping relaxations, but
+    // neither of those can introduce poison, so NaN and infinity stay ordinary values
+    let mut assoc = builder.clone();
+    assoc.flag("-fassociative-math");
+    assoc.flag("-fno-signed-zeros");
+    assoc.flag("-fno-trapping-math");
+    assoc.flag("-ffp-contract=fast");
+    assoc.flag("-fno-math-errno");
+    assoc.file("src/math/assoc.c").compile("assoc");
+
+    // the full flag set for the FF types
     builder.flag("-fassociative-math");
     builder.flag("-freciprocal-math");
     builder.flag("-fno-signed-zeros");
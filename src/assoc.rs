@@ -0,0 +1,295 @@
+//! Policy-relaxed fast types that enable only reassociation.
+//!
+//! [`FF32`](crate::FF32) and [`FF64`](crate::FF64) are compiled with the full fast-math flag
+//! set, including finite-math-only -- which rules them out wherever NaN or infinity are
+//! legitimate values. [`AF32`] and [`AF64`] are backed by a kernel library compiled with only
+//! `-fassociative-math` (plus the `-fno-signed-zeros`/`-fno-trapping-math` flags clang
+//! requires for it to take effect) and `-ffp-contract=fast`, so reductions still vectorize
+//! into multi-lane partial accumulators and multiply-adds still fuse, while NaN and infinity
+//! remain ordinary IEEE values with their usual semantics.
+//!
+//! Because nothing in that flag set can introduce poison, these types carry none of the
+//! poison machinery: no freezing, and comparisons are plain primitive comparisons. The price
+//! is the rest of the flag family -- no reciprocal approximations, no finite-math value
+//! folding -- and a deliberately smaller surface: the arithmetic operators, `mul_add`, and
+//! the `sum`/`dot` slice reductions. Pick the policy per call site: the full fast types
+//! where values are known finite, these where they are not.
+
+use core::fmt;
+use core::iter::{Product, Sum};
+use core::ops::{
+    Add, AddAssign, Div, DivAssign, Mul, MulAssign, Neg, Sub, SubAssign,
+};
+use paste::paste;
+
+macro_rules! impl_assoc {
+    ($fast_ty:ident, $ctor:ident, $base_ty:ident) => {
+        paste! {
+            #[doc = "A wrapper over `"]
+            #[doc = stringify!($base_ty)]
+            #[doc = "` which enables only reassociation (and contraction) fast-math optimizations."]
+            ///
+            /// Unlike the full fast types there is no finite-math restriction: NaN and
+            /// infinity are ordinary values, and no operation produces poison. See the
+            /// [module docs](self) for the trade
+            #[derive(Clone, Copy, Default, PartialEq, PartialOrd)]
+            #[repr(transparent)]
+            pub struct $fast_ty($base_ty);
+
+            #[doc = "Create a new `"]
+            #[doc = stringify!($fast_ty)]
+            #[doc = "` instance from the given float value."]
+            ///
+            #[doc = "This is syntax sugar for constructing the `"]
+            #[doc = stringify!($fast_ty)]
+            #[doc = "` type, and equivalent to `"]
+            #[doc = stringify!($fast_ty)]
+            #[doc = "::new(f)`. Any value is permitted, including NaN and infinity"]
+            #[inline(always)]
+            pub fn $ctor(f: $base_ty) -> $fast_ty {
+                $fast_ty::new(f)
+            }
+
+            #[cfg(not(feature = "fallback"))]
+            #[link(name = "assoc")]
+            extern "C" {
+                // no poison can be involved in either direction, so the primitives are
+                // passed bare
+                fn [<add_assoc_ $base_ty>](a: $base_ty, b: $base_ty) -> $base_ty;
+                fn [<sub_assoc_ $base_ty>](a: $base_ty, b: $base_ty) -> $base_ty;
+                fn [<mul_assoc_ $base_ty>](a: $base_ty, b: $base_ty) -> $base_ty;
+                fn [<div_assoc_ $base_ty>](a: $base_ty, b: $base_ty) -> $base_ty;
+                fn [<neg_assoc_ $base_ty>](a: $base_ty) -> $base_ty;
+                fn [<mul_add_assoc_ $base_ty>](
+                    a: $base_ty,
+                    b: $base_ty,
+                    c: $base_ty,
+                ) -> $base_ty;
+                fn [<sum_slice_assoc_ $base_ty>](ptr: *const $base_ty, len: usize) -> $base_ty;
+                fn [<dot_slice_assoc_ $base_ty>](
+                    a: *const $base_ty,
+                    b: *const $base_ty,
+                    len: usize,
+                ) -> $base_ty;
+            }
+
+            #[cfg(feature = "fallback")]
+            mod [<fallback_ $base_ty>] {
+                // pure-rust shims mirroring the kernel symbols, as in crate::math::fallback
+                pub(super) unsafe fn [<add_assoc_ $base_ty>](a: $base_ty, b: $base_ty) -> $base_ty {
+                    a + b
+                }
+                pub(super) unsafe fn [<sub_assoc_ $base_ty>](a: $base_ty, b: $base_ty) -> $base_ty {
+                    a - b
+                }
+                pub(super) unsafe fn [<mul_assoc_ $base_ty>](a: $base_ty, b: $base_ty) -> $base_ty {
+                    a * b
+                }
+                pub(super) unsafe fn [<div_assoc_ $base_ty>](a: $base_ty, b: $base_ty) -> $base_ty {
+                    a / b
+                }
+                pub(super) unsafe fn [<neg_assoc_ $base_ty>](a: $base_ty) -> $base_ty {
+                    -a
+                }
+                pub(super) unsafe fn [<mul_add_assoc_ $base_ty>](
+                    a: $base_ty,
+                    b: $base_ty,
+                    c: $base_ty,
+                ) -> $base_ty {
+                    a.mul_add(b, c)
+                }
+                pub(super) unsafe fn [<sum_slice_assoc_ $base_ty>](
+                    ptr: *const $base_ty,
+                    len: usize,
+                ) -> $base_ty {
+                    core::slice::from_raw_parts(ptr, len).iter().sum()
+                }
+                pub(super) unsafe fn [<dot_slice_assoc_ $base_ty>](
+                    a: *const $base_ty,
+                    b: *const $base_ty,
+                    len: usize,
+                ) -> $base_ty {
+                    let a = core::slice::from_raw_parts(a, len);
+                    let b = core::slice::from_raw_parts(b, len);
+                    let mut acc = 0.0;
+                    for i in 0..len {
+                        acc = a[i].mul_add(b[i], acc);
+                    }
+                    acc
+                }
+            }
+            #[cfg(feature = "fallback")]
+            use [<fallback_ $base_ty>]::*;
+
+            impl $fast_ty {
+                pub const ZERO: Self = Self::new(0.0);
+                pub const ONE: Self = Self::new(1.0);
+
+                #[doc = "Create a new `"]
+                #[doc = stringify!($fast_ty)]
+                #[doc = "` instance from the given float value."]
+                ///
+                /// Any value is permitted, including NaN and infinity
+                #[inline(always)]
+                pub const fn new(f: $base_ty) -> Self {
+                    $fast_ty(f)
+                }
+
+                /// The wrapped primitive value
+                #[inline(always)]
+                pub const fn value(self) -> $base_ty {
+                    self.0
+                }
+
+                /// Fused multiply-add, `(self * mul) + add`
+                #[inline(always)]
+                pub fn mul_add(self, mul: Self, add: Self) -> Self {
+                    $fast_ty(unsafe { [<mul_add_assoc_ $base_ty>](self.0, mul.0, add.0) })
+                }
+
+                /// Sum all elements of the slice, returning zero for an empty slice.
+                ///
+                /// The whole reduction runs inside one reassociation-enabled kernel, which
+                /// may vectorize it into partial sums; NaN and infinity propagate as usual
+                #[inline]
+                pub fn sum(values: &[Self]) -> Self {
+                    // the policy type is repr(transparent) over the primitive
+                    $fast_ty(unsafe {
+                        [<sum_slice_assoc_ $base_ty>](
+                            values.as_ptr() as *const $base_ty,
+                            values.len(),
+                        )
+                    })
+                }
+
+                /// The dot product of the two slices, zero if they are empty.
+                ///
+                /// # Panics
+                ///
+                /// Panics if the slices have different lengths
+                #[inline]
+                pub fn dot(a: &[Self], b: &[Self]) -> Self {
+                    assert_eq!(a.len(), b.len());
+                    $fast_ty(unsafe {
+                        [<dot_slice_assoc_ $base_ty>](
+                            a.as_ptr() as *const $base_ty,
+                            b.as_ptr() as *const $base_ty,
+                            a.len(),
+                        )
+                    })
+                }
+            }
+
+            impl From<$base_ty> for $fast_ty {
+                #[inline(always)]
+                fn from(from: $base_ty) -> Self {
+                    $fast_ty(from)
+                }
+            }
+
+            impl From<$fast_ty> for $base_ty {
+                #[inline(always)]
+                fn from(from: $fast_ty) -> Self {
+                    from.0
+                }
+            }
+
+            impl_assoc_binary_ops! {
+                $fast_ty, $base_ty:
+                Add, add, AddAssign, add_assign, [<add_assoc_ $base_ty>],
+                Sub, sub, SubAssign, sub_assign, [<sub_assoc_ $base_ty>],
+                Mul, mul, MulAssign, mul_assign, [<mul_assoc_ $base_ty>],
+                Div, div, DivAssign, div_assign, [<div_assoc_ $base_ty>],
+            }
+
+            impl Neg for $fast_ty {
+                type Output = Self;
+
+                #[inline(always)]
+                fn neg(self) -> Self::Output {
+                    $fast_ty(unsafe { [<neg_assoc_ $base_ty>](self.0) })
+                }
+            }
+
+            // folding through the always_inline add kernel keeps the whole chain in a
+            // reassociable context, so the optimizer is free to split it into partial sums
+            impl Sum for $fast_ty {
+                #[inline]
+                fn sum<I: Iterator<Item = Self>>(iter: I) -> Self {
+                    iter.fold(Self::ZERO, Add::add)
+                }
+            }
+
+            impl Product for $fast_ty {
+                #[inline]
+                fn product<I: Iterator<Item = Self>>(iter: I) -> Self {
+                    iter.fold(Self::ONE, Mul::mul)
+                }
+            }
+
+            impl fmt::Debug for $fast_ty {
+                fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                    <$base_ty as fmt::Debug>::fmt(&self.0, f)
+                }
+            }
+
+            impl fmt::Display for $fast_ty {
+                fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                    <$base_ty as fmt::Display>::fmt(&self.0, f)
+                }
+            }
+
+        }
+    };
+}
+
+macro_rules! impl_assoc_binary_ops {
+    ($fast_ty:ident, $base_ty:ident:
+     $($op_trait:ident, $op_fn:ident, $assign_trait:ident, $assign_fn:ident, $op_impl:ident,)*) => {
+        $(
+            impl $op_trait<$fast_ty> for $fast_ty {
+                type Output = $fast_ty;
+
+                #[inline(always)]
+                fn $op_fn(self, other: $fast_ty) -> Self::Output {
+                    $fast_ty(unsafe { $op_impl(self.0, other.0) })
+                }
+            }
+
+            impl $op_trait<$base_ty> for $fast_ty {
+                type Output = $fast_ty;
+
+                #[inline(always)]
+                fn $op_fn(self, other: $base_ty) -> Self::Output {
+                    self.$op_fn($fast_ty(other))
+                }
+            }
+
+            impl $op_trait<$fast_ty> for $base_ty {
+                type Output = $fast_ty;
+
+                #[inline(always)]
+                fn $op_fn(self, other: $fast_ty) -> Self::Output {
+                    $fast_ty(self).$op_fn(other)
+                }
+            }
+
+            impl $assign_trait<$fast_ty> for $fast_ty {
+                #[inline(always)]
+                fn $assign_fn(&mut self, other: $fast_ty) {
+                    *self = self.$op_fn(other);
+                }
+            }
+
+            impl $assign_trait<$base_ty> for $fast_ty {
+                #[inline(always)]
+                fn $assign_fn(&mut self, other: $base_ty) {
+                    *self = self.$op_fn(other);
+                }
+            }
+        )*
+    };
+}
+
+impl_assoc! { AF32, af32, f32 }
+impl_assoc! { AF64, af64, f64 }
@@ -0,0 +1,26 @@
+#![cfg(feature = "bytemuck")]
+#![cfg_attr(docsrs, doc(cfg(feature = "bytemuck")))]
+
+use crate::{FF32x4, FF32x8, FF64x2, FF64x4, FF32, FF64};
+
+// The fast types accept any bit pattern (the value-range restrictions are about unspecified
+// results, not validity), so Zeroable and AnyBitPattern are sound and allow zero-copy casts
+// *into* the fast types through bytemuck.
+//
+// NoUninit (and therefore Pod) is deliberately not implemented: casting *out* of a fast type
+// must go through the freeze boundary (`From<FF32> for f32`, `slice::freeze`), otherwise poison
+// values could leak into the base primitives.
+
+macro_rules! impl_bytemuck {
+    ($($ty:ident,)*) => {
+        $(
+            unsafe impl ::bytemuck::Zeroable for $ty {}
+            unsafe impl ::bytemuck::AnyBitPattern for $ty {}
+        )*
+    };
+}
+
+impl_bytemuck! {
+    FF32, FF64,
+    FF32x4, FF32x8, FF64x2, FF64x4,
+}
@@ -0,0 +1,118 @@
+#![cfg(feature = "diagnostics")]
+#![cfg_attr(docsrs, doc(cfg(feature = "diagnostics")))]
+
+//! Sampled detection of finite-math contract violations.
+//!
+//! When a non-finite value enters the crate the outputs become unspecified, and that usually
+//! surfaces as garbage results long after the fact. [`new_checked`](crate::FF32::new_checked)
+//! can validate individual values, but per-call `Result` handling is too slow for ingest hot
+//! paths. This module instead samples: the [`ff32`](crate::ff32)/[`ff64`](crate::ff64)
+//! constructors and the freeze boundary check roughly one in
+//! [`sample interval`](set_sample_interval) values using a per-thread countdown, so the hot
+//! path pays one thread-local decrement and a predictable branch. Violation totals (and the
+//! first offending construction site) are recorded in relaxed global counters and can be read
+//! at any time with [`report`], making it cheap enough to leave enabled in canary deployments.
+
+use core::cell::Cell;
+use core::panic::Location;
+use core::ptr;
+use core::sync::atomic::{AtomicPtr, AtomicU32, AtomicU64, Ordering::Relaxed};
+
+static SAMPLE_INTERVAL: AtomicU32 = AtomicU32::new(1024);
+static CHECKS: AtomicU64 = AtomicU64::new(0);
+static VIOLATIONS: AtomicU64 = AtomicU64::new(0);
+static FIRST_SITE: AtomicPtr<Location<'static>> = AtomicPtr::new(ptr::null_mut());
+
+thread_local! {
+    // counts down to the next check; starting at 0 means every thread's first value is
+    // checked, so violations in short-lived threads aren't missed entirely
+    static COUNTDOWN: Cell<u32> = Cell::new(0);
+}
+
+/// A snapshot of the violation counters
+#[derive(Debug, Clone, Copy)]
+pub struct Report {
+    /// How many values have been sample-checked
+    pub checks: u64,
+    /// How many checked values were infinite or NaN
+    pub violations: u64,
+    /// The construction site of the first recorded violation, when it was one of the
+    /// tracked constructors ([`ff32`](crate::ff32)/[`ff64`](crate::ff64)). Violations first
+    /// observed at the freeze boundary have no meaningful single site and record the
+    /// internal caller instead
+    pub first_site: Option<&'static Location<'static>>,
+}
+
+/// A snapshot of the counters accumulated since startup (or the last [`reset`])
+pub fn report() -> Report {
+    let first_site = FIRST_SITE.load(Relaxed);
+    Report {
+        checks: CHECKS.load(Relaxed),
+        violations: VIOLATIONS.load(Relaxed),
+        // the pointer is only ever set from a &'static Location
+        first_site: unsafe { first_site.cast_const().as_ref() },
+    }
+}
+
+/// Reset the counters and the recorded first violation site
+pub fn reset() {
+    CHECKS.store(0, Relaxed);
+    VIOLATIONS.store(0, Relaxed);
+    FIRST_SITE.store(ptr::null_mut(), Relaxed);
+}
+
+/// Check roughly one in `n` values (per thread); `n = 1` checks every value.
+///
+/// The default is 1024, which keeps the overhead well under a percent of the arithmetic it
+/// instruments while still catching sustained violations quickly
+pub fn set_sample_interval(n: u32) {
+    SAMPLE_INTERVAL.store(n.max(1), Relaxed);
+}
+
+pub(crate) trait Sampled: Copy {
+    fn is_violation(self) -> bool;
+}
+
+impl Sampled for f32 {
+    #[inline(always)]
+    fn is_violation(self) -> bool {
+        !self.is_finite()
+    }
+}
+
+impl Sampled for f64 {
+    #[inline(always)]
+    fn is_violation(self) -> bool {
+        !self.is_finite()
+    }
+}
+
+// the hot-path hook: one thread-local decrement and branch per instrumented call
+#[inline(always)]
+#[track_caller]
+pub(crate) fn sample<T: Sampled>(value: T) {
+    let due = COUNTDOWN.with(|countdown| {
+        let n = countdown.get();
+        if n == 0 {
+            countdown.set(SAMPLE_INTERVAL.load(Relaxed) - 1);
+            true
+        } else {
+            countdown.set(n - 1);
+            false
+        }
+    });
+    if due {
+        CHECKS.fetch_add(1, Relaxed);
+        if value.is_violation() {
+            violation(Location::caller());
+        }
+    }
+}
+
+#[cold]
+fn violation(site: &'static Location<'static>) {
+    VIOLATIONS.fetch_add(1, Relaxed);
+    let site = site as *const Location<'static> as *mut Location<'static>;
+    // only the first site is kept; later violations just bump the count
+    let _ = FIRST_SITE.compare_exchange(ptr::null_mut(), site, Relaxed, Relaxed);
+}
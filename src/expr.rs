@@ -0,0 +1,543 @@
+//! Lazily evaluated elementwise expressions over slices of the fast types.
+//!
+//! Composite expressions over buffers otherwise cost one pass (and often one temporary) per
+//! operator, because every operator on the scalar types is eager. An [`Expr`] instead captures
+//! the operand slices and the operation tree, and evaluation walks the whole tree once per
+//! element, so arbitrary elementwise pipelines run in a single memory pass through the fast-math
+//! kernels.
+//!
+//! ```
+//! use fast_fp::{expr, ff32, FF32};
+//!
+//! let a = vec![ff32(1.0); 16];
+//! let b = vec![ff32(2.0); 16];
+//! let c = vec![ff32(3.0); 16];
+//! let mut out = vec![ff32(0.0); 16];
+//!
+//! // one fused loop: out[i] = a[i] * b[i] + c[i].clamp(0.0, 2.5)
+//! (expr::slice(&a) * expr::slice(&b) + expr::slice(&c).clamp(ff32(0.0), ff32(2.5)))
+//!     .eval_into(&mut out);
+//!
+//! assert_eq!(out[0], ff32(4.5));
+//! ```
+
+use crate::{FF32, FF64};
+use core::marker::PhantomData;
+use core::ops::{Add, Div, Mul, Neg, Sub};
+
+/// A lazy elementwise expression.
+///
+/// Built from [`slice`] and [`scalar`] operands combined with the standard operators and the
+/// methods on this type; nothing is computed until [`eval`](Expr::eval) or
+/// [`eval_into`](Expr::eval_into)
+#[derive(Clone, Copy)]
+pub struct Expr<E>(E);
+
+/// An expression node; implemented by the operand and operator types in this module
+pub trait Node: Copy {
+    /// The element type the node produces
+    type Elem: Copy;
+
+    /// The common length of the node's slice operands, or `None` if it only contains broadcast
+    /// scalars.
+    ///
+    /// Panics if two slice operands have different lengths
+    fn len(&self) -> Option<usize>;
+
+    /// Compute the element at `index`
+    fn get(&self, index: usize) -> Self::Elem;
+}
+
+/// Conversion into an expression, allowing operands to be other expressions, slices, or scalars
+pub trait IntoExpr {
+    /// The node type of the resulting expression
+    type Node: Node;
+
+    fn into_expr(self) -> Expr<Self::Node>;
+}
+
+/// A slice operand; every element participates positionally
+#[derive(Clone, Copy)]
+pub struct Slice<'a, T>(&'a [T]);
+
+/// A scalar operand broadcast across every element
+#[derive(Clone, Copy)]
+pub struct Broadcast<T>(T);
+
+/// A node applying a binary operation to two sub-expressions
+#[derive(Clone, Copy)]
+pub struct Binary<Op, L, R> {
+    lhs: L,
+    rhs: R,
+    op: PhantomData<Op>,
+}
+
+/// A node applying a unary operation to a sub-expression
+#[derive(Clone, Copy)]
+pub struct Unary<Op, E> {
+    inner: E,
+    op: PhantomData<Op>,
+}
+
+/// A node applying a ternary operation to three sub-expressions
+#[derive(Clone, Copy)]
+pub struct Ternary<Op, A, B, C> {
+    a: A,
+    b: B,
+    c: C,
+    op: PhantomData<Op>,
+}
+
+/// Create an expression from a slice of values
+#[inline]
+pub fn slice<T: Copy>(values: &[T]) -> Expr<Slice<'_, T>> {
+    Expr(Slice(values))
+}
+
+/// Create an expression broadcasting one value across every element
+#[inline]
+pub fn scalar<T: Copy>(value: T) -> Expr<Broadcast<T>> {
+    Expr(Broadcast(value))
+}
+
+impl<'a, T: Copy> Node for Slice<'a, T> {
+    type Elem = T;
+
+    #[inline(always)]
+    fn len(&self) -> Option<usize> {
+        Some(self.0.len())
+    }
+
+    #[inline(always)]
+    fn get(&self, index: usize) -> T {
+        self.0[index]
+    }
+}
+
+impl<T: Copy> Node for Broadcast<T> {
+    type Elem = T;
+
+    #[inline(always)]
+    fn len(&self) -> Option<usize> {
+        None
+    }
+
+    #[inline(always)]
+    fn get(&self, _: usize) -> T {
+        self.0
+    }
+}
+
+#[inline]
+fn merge_len(a: Option<usize>, b: Option<usize>) -> Option<usize> {
+    match (a, b) {
+        (Some(a), Some(b)) => {
+            assert_eq!(a, b, "expression operand lengths differ");
+            Some(a)
+        }
+        (Some(len), None) | (None, Some(len)) => Some(len),
+        (None, None) => None,
+    }
+}
+
+/// A binary operation applied elementwise by [`Binary`] nodes
+pub trait BinaryOp<T>: Copy {
+    fn apply(lhs: T, rhs: T) -> T;
+}
+
+/// A unary operation applied elementwise by [`Unary`] nodes
+pub trait UnaryOp<T>: Copy {
+    fn apply(value: T) -> T;
+}
+
+/// A ternary operation applied elementwise by [`Ternary`] nodes
+pub trait TernaryOp<T>: Copy {
+    fn apply(a: T, b: T, c: T) -> T;
+}
+
+impl<Op, L, R> Node for Binary<Op, L, R>
+where
+    L: Node,
+    R: Node<Elem = L::Elem>,
+    Op: BinaryOp<L::Elem>,
+{
+    type Elem = L::Elem;
+
+    #[inline(always)]
+    fn len(&self) -> Option<usize> {
+        merge_len(self.lhs.len(), self.rhs.len())
+    }
+
+    #[inline(always)]
+    fn get(&self, index: usize) -> Self::Elem {
+        Op::apply(self.lhs.get(index), self.rhs.get(index))
+    }
+}
+
+impl<Op, E> Node for Unary<Op, E>
+where
+    E: Node,
+    Op: UnaryOp<E::Elem>,
+{
+    type Elem = E::Elem;
+
+    #[inline(always)]
+    fn len(&self) -> Option<usize> {
+        self.inner.len()
+    }
+
+    #[inline(always)]
+    fn get(&self, index: usize) -> Self::Elem {
+        Op::apply(self.inner.get(index))
+    }
+}
+
+impl<Op, A, B, C> Node for Ternary<Op, A, B, C>
+where
+    A: Node,
+    B: Node<Elem = A::Elem>,
+    C: Node<Elem = A::Elem>,
+    Op: TernaryOp<A::Elem>,
+{
+    type Elem = A::Elem;
+
+    #[inline(always)]
+    fn len(&self) -> Option<usize> {
+        merge_len(merge_len(self.a.len(), self.b.len()), self.c.len())
+    }
+
+    #[inline(always)]
+    fn get(&self, index: usize) -> Self::Elem {
+        Op::apply(self.a.get(index), self.b.get(index), self.c.get(index))
+    }
+}
+
+macro_rules! op_markers {
+    ($($(#[$attr:meta])* $name:ident,)*) => {
+        $(
+            $(#[$attr])*
+            #[derive(Clone, Copy)]
+            pub struct $name;
+        )*
+    };
+}
+
+op_markers! {
+    /// Elementwise addition
+    AddOp,
+    /// Elementwise subtraction
+    SubOp,
+    /// Elementwise multiplication
+    MulOp,
+    /// Elementwise division
+    DivOp,
+    /// Elementwise negation
+    NegOp,
+    /// Elementwise minimum
+    MinOp,
+    /// Elementwise maximum
+    MaxOp,
+    /// Elementwise absolute value
+    AbsOp,
+    /// Elementwise clamp
+    ClampOp,
+    /// Elementwise fused multiply-add
+    MulAddOp,
+}
+
+impl<T: Add<Output = T> + Copy> BinaryOp<T> for AddOp {
+    #[inline(always)]
+    fn apply(lhs: T, rhs: T) -> T {
+        lhs + rhs
+    }
+}
+
+impl<T: Sub<Output = T> + Copy> BinaryOp<T> for SubOp {
+    #[inline(always)]
+    fn apply(lhs: T, rhs: T) -> T {
+        lhs - rhs
+    }
+}
+
+impl<T: Mul<Output = T> + Copy> BinaryOp<T> for MulOp {
+    #[inline(always)]
+    fn apply(lhs: T, rhs: T) -> T {
+        lhs * rhs
+    }
+}
+
+impl<T: Div<Output = T> + Copy> BinaryOp<T> for DivOp {
+    #[inline(always)]
+    fn apply(lhs: T, rhs: T) -> T {
+        lhs / rhs
+    }
+}
+
+impl<T: Neg<Output = T> + Copy> UnaryOp<T> for NegOp {
+    #[inline(always)]
+    fn apply(value: T) -> T {
+        -value
+    }
+}
+
+macro_rules! impl_elem_ops {
+    ($($fast_ty:ident,)*) => {
+        $(
+            impl BinaryOp<$fast_ty> for MinOp {
+                #[inline(always)]
+                fn apply(lhs: $fast_ty, rhs: $fast_ty) -> $fast_ty {
+                    lhs.min(rhs)
+                }
+            }
+
+            impl BinaryOp<$fast_ty> for MaxOp {
+                #[inline(always)]
+                fn apply(lhs: $fast_ty, rhs: $fast_ty) -> $fast_ty {
+                    lhs.max(rhs)
+                }
+            }
+
+            impl UnaryOp<$fast_ty> for AbsOp {
+                #[inline(always)]
+                fn apply(value: $fast_ty) -> $fast_ty {
+                    value.abs()
+                }
+            }
+
+            impl TernaryOp<$fast_ty> for ClampOp {
+                #[inline(always)]
+                fn apply(value: $fast_ty, min: $fast_ty, max: $fast_ty) -> $fast_ty {
+                    // max-then-min rather than the scalar clamp method, whose min <= max assert
+                    // would freeze both bounds on every element
+                    value.max(min).min(max)
+                }
+            }
+
+            impl TernaryOp<$fast_ty> for MulAddOp {
+                #[inline(always)]
+                fn apply(value: $fast_ty, mul: $fast_ty, add: $fast_ty) -> $fast_ty {
+                    value.mul_add(mul, add)
+                }
+            }
+        )*
+    };
+}
+
+impl_elem_ops! { FF32, FF64, }
+
+impl<E: Node> IntoExpr for Expr<E> {
+    type Node = E;
+
+    #[inline(always)]
+    fn into_expr(self) -> Expr<E> {
+        self
+    }
+}
+
+impl<'a, T: Copy> IntoExpr for &'a [T] {
+    type Node = Slice<'a, T>;
+
+    #[inline(always)]
+    fn into_expr(self) -> Expr<Slice<'a, T>> {
+        slice(self)
+    }
+}
+
+macro_rules! impl_into_expr_scalar {
+    ($($fast_ty:ident, $base_ty:ident,)*) => {
+        $(
+            impl IntoExpr for $fast_ty {
+                type Node = Broadcast<$fast_ty>;
+
+                #[inline(always)]
+                fn into_expr(self) -> Expr<Broadcast<$fast_ty>> {
+                    scalar(self)
+                }
+            }
+
+            impl IntoExpr for $base_ty {
+                type Node = Broadcast<$fast_ty>;
+
+                #[inline(always)]
+                fn into_expr(self) -> Expr<Broadcast<$fast_ty>> {
+                    scalar(<$fast_ty>::new(self))
+                }
+            }
+        )*
+    };
+}
+
+impl_into_expr_scalar! { FF32, f32, FF64, f64, }
+
+macro_rules! impl_expr_operators {
+    ($($op_trait:ident, $op_fn:ident, $op_marker:ident,)*) => {
+        $(
+            impl<E, R> $op_trait<R> for Expr<E>
+            where
+                E: Node,
+                R: IntoExpr,
+                R::Node: Node<Elem = E::Elem>,
+                $op_marker: BinaryOp<E::Elem>,
+            {
+                type Output = Expr<Binary<$op_marker, E, R::Node>>;
+
+                #[inline]
+                fn $op_fn(self, rhs: R) -> Self::Output {
+                    Expr(Binary {
+                        lhs: self.0,
+                        rhs: rhs.into_expr().0,
+                        op: PhantomData,
+                    })
+                }
+            }
+        )*
+    };
+}
+
+impl_expr_operators! {
+    Add, add, AddOp,
+    Sub, sub, SubOp,
+    Mul, mul, MulOp,
+    Div, div, DivOp,
+}
+
+impl<E> Neg for Expr<E>
+where
+    E: Node,
+    NegOp: UnaryOp<E::Elem>,
+{
+    type Output = Expr<Unary<NegOp, E>>;
+
+    #[inline]
+    fn neg(self) -> Self::Output {
+        Expr(Unary {
+            inner: self.0,
+            op: PhantomData,
+        })
+    }
+}
+
+impl<E: Node> Expr<E> {
+    /// Elementwise minimum with another expression, slice, or scalar
+    #[inline]
+    pub fn min<R>(self, other: R) -> Expr<Binary<MinOp, E, R::Node>>
+    where
+        R: IntoExpr,
+        R::Node: Node<Elem = E::Elem>,
+        MinOp: BinaryOp<E::Elem>,
+    {
+        Expr(Binary {
+            lhs: self.0,
+            rhs: other.into_expr().0,
+            op: PhantomData,
+        })
+    }
+
+    /// Elementwise maximum with another expression, slice, or scalar
+    #[inline]
+    pub fn max<R>(self, other: R) -> Expr<Binary<MaxOp, E, R::Node>>
+    where
+        R: IntoExpr,
+        R::Node: Node<Elem = E::Elem>,
+        MaxOp: BinaryOp<E::Elem>,
+    {
+        Expr(Binary {
+            lhs: self.0,
+            rhs: other.into_expr().0,
+            op: PhantomData,
+        })
+    }
+
+    /// Elementwise absolute value
+    #[inline]
+    pub fn abs(self) -> Expr<Unary<AbsOp, E>>
+    where
+        AbsOp: UnaryOp<E::Elem>,
+    {
+        Expr(Unary {
+            inner: self.0,
+            op: PhantomData,
+        })
+    }
+
+    /// Elementwise clamp between `min` and `max`.
+    ///
+    /// Elements where `min > max` produce unspecified values
+    #[inline]
+    pub fn clamp<Min, Max>(self, min: Min, max: Max) -> Expr<Ternary<ClampOp, E, Min::Node, Max::Node>>
+    where
+        Min: IntoExpr,
+        Max: IntoExpr,
+        Min::Node: Node<Elem = E::Elem>,
+        Max::Node: Node<Elem = E::Elem>,
+        ClampOp: TernaryOp<E::Elem>,
+    {
+        Expr(Ternary {
+            a: self.0,
+            b: min.into_expr().0,
+            c: max.into_expr().0,
+            op: PhantomData,
+        })
+    }
+
+    /// Elementwise fused multiply-add: `self * mul + add`
+    #[inline]
+    pub fn mul_add<M, A>(self, mul: M, add: A) -> Expr<Ternary<MulAddOp, E, M::Node, A::Node>>
+    where
+        M: IntoExpr,
+        A: IntoExpr,
+        M::Node: Node<Elem = E::Elem>,
+        A::Node: Node<Elem = E::Elem>,
+        MulAddOp: TernaryOp<E::Elem>,
+    {
+        Expr(Ternary {
+            a: self.0,
+            b: mul.into_expr().0,
+            c: add.into_expr().0,
+            op: PhantomData,
+        })
+    }
+
+    /// The common length of the expression's slice operands, or `None` if it only contains
+    /// broadcast scalars.
+    ///
+    /// # Panics
+    ///
+    /// Panics if two slice operands have different lengths
+    #[inline]
+    pub fn len(&self) -> Option<usize> {
+        self.0.len()
+    }
+
+    /// Evaluate the whole expression in a single pass, writing into `out`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if operand lengths differ among themselves or from `out`, or if the expression
+    /// contains no slice operands
+    pub fn eval_into(self, out: &mut [E::Elem]) {
+        let len = self
+            .len()
+            .expect("expression has no slice operands");
+        assert_eq!(len, out.len(), "output length differs from operand length");
+        for i in 0..len {
+            out[i] = self.0.get(i);
+        }
+    }
+
+    /// Evaluate the whole expression in a single pass into a newly allocated `Vec`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if operand lengths differ, or if the expression contains no slice operands
+    pub fn eval(self) -> Vec<E::Elem> {
+        let len = self
+            .len()
+            .expect("expression has no slice operands");
+        let mut out = Vec::with_capacity(len);
+        for i in 0..len {
+            out.push(self.0.get(i));
+        }
+        out
+    }
+}
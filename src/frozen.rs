@@ -0,0 +1,243 @@
+use crate::{FF32, FF64};
+use core::cmp::Ordering;
+use core::fmt;
+use core::hash::{Hash, Hasher};
+
+// Comparing the fast types must freeze both operands on every comparison to keep poison out of
+// the resulting bool, so O(n log n) comparison algorithms pay O(n log n) freezes. The frozen
+// wrappers freeze exactly once at construction, then compare, order, and hash the fixed bits
+// with no further FFI calls.
+
+macro_rules! impl_frozen {
+    ($(
+        $(#[$attr:meta])*
+        $frozen_ty:ident, $fast_ty:ident, $base_ty:ident, $bits_ty:ty, $ubits_ty:ty, $shift:expr;
+    )*) => {
+        $(
+            $(#[$attr])*
+            ///
+            /// Comparisons use the IEEE 754 total order of the frozen bits, which for the
+            /// finite values this crate's contract requires matches the usual numeric order
+            /// (except that `-0.0` orders below `+0.0`)
+            // transparent over the primitive, so frozen slices can be reinterpreted as
+            // slices of the wrapper (the batch sort in `crate::slice` relies on this)
+            #[derive(Clone, Copy)]
+            #[repr(transparent)]
+            pub struct $frozen_ty($base_ty);
+
+            impl $frozen_ty {
+                #[doc = "Create a new `"]
+                #[doc = stringify!($frozen_ty)]
+                #[doc = "` from an already-concrete primitive value"]
+                #[inline(always)]
+                pub const fn new(value: $base_ty) -> Self {
+                    $frozen_ty(value)
+                }
+
+                /// The concrete primitive value
+                #[inline(always)]
+                pub const fn get(self) -> $base_ty {
+                    self.0
+                }
+
+                // IEEE 754 totalOrder key: flipping the sign bit of non-negative values and all
+                // bits of negative values yields integers that order like the floats
+                #[inline(always)]
+                fn key(self) -> $bits_ty {
+                    let bits = self.0.to_bits() as $bits_ty;
+                    bits ^ ((((bits >> $shift) as $ubits_ty) >> 1) as $bits_ty)
+                }
+            }
+
+            impl $fast_ty {
+                /// Freeze this value once, returning a wrapper that can be compared, ordered,
+                /// and hashed with no further freezing.
+                ///
+                /// Converting back with `From` is free
+                #[inline]
+                pub fn frozen(self) -> $frozen_ty {
+                    $frozen_ty::new(self.freeze_raw())
+                }
+            }
+
+            impl PartialEq for $frozen_ty {
+                #[inline(always)]
+                fn eq(&self, other: &Self) -> bool {
+                    self.key() == other.key()
+                }
+            }
+
+            impl Eq for $frozen_ty {}
+
+            impl PartialOrd for $frozen_ty {
+                #[inline(always)]
+                fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
+                    Some(self.cmp(other))
+                }
+            }
+
+            impl Ord for $frozen_ty {
+                #[inline(always)]
+                fn cmp(&self, other: &Self) -> Ordering {
+                    self.key().cmp(&other.key())
+                }
+            }
+
+            impl Hash for $frozen_ty {
+                // the total order key is a bijection of the bits, so hashing the bits is
+                // consistent with Eq
+                #[inline]
+                fn hash<H: Hasher>(&self, state: &mut H) {
+                    self.0.to_bits().hash(state)
+                }
+            }
+
+            impl From<$fast_ty> for $frozen_ty {
+                #[inline]
+                fn from(from: $fast_ty) -> Self {
+                    from.frozen()
+                }
+            }
+
+            impl From<$frozen_ty> for $fast_ty {
+                #[inline(always)]
+                fn from(from: $frozen_ty) -> Self {
+                    <$fast_ty>::new(from.0)
+                }
+            }
+
+            impl From<$base_ty> for $frozen_ty {
+                #[inline(always)]
+                fn from(from: $base_ty) -> Self {
+                    $frozen_ty::new(from)
+                }
+            }
+
+            impl From<$frozen_ty> for $base_ty {
+                #[inline(always)]
+                fn from(from: $frozen_ty) -> Self {
+                    from.0
+                }
+            }
+
+            impl fmt::Debug for $frozen_ty {
+                fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                    <$base_ty as fmt::Debug>::fmt(&self.0, f)
+                }
+            }
+
+            impl fmt::Display for $frozen_ty {
+                fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                    <$base_ty as fmt::Display>::fmt(&self.0, f)
+                }
+            }
+        )*
+    };
+}
+
+impl_frozen! {
+    /// A concrete value frozen out of an [`FF32`], ordered and hashable without further
+    /// freeze calls.
+    Frozen32, FF32, f32, i32, u32, 31;
+
+    /// A concrete value frozen out of an [`FF64`], ordered and hashable without further
+    /// freeze calls.
+    Frozen64, FF64, f64, i64, u64, 63;
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    // the wrappers are built from already-concrete primitives, so the key construction is
+    // testable without any freeze kernel. Both widths are covered since they use different
+    // shift constants
+
+    #[test]
+    fn total_order_matches_numeric_order_f32() {
+        let ordered = [
+            f32::NEG_INFINITY,
+            f32::MIN,
+            -1.0,
+            -f32::MIN_POSITIVE,
+            -f32::from_bits(1), // smallest-magnitude negative subnormal
+            -0.0,
+            0.0,
+            f32::from_bits(1),
+            f32::MIN_POSITIVE,
+            1.0,
+            f32::MAX,
+            f32::INFINITY,
+        ];
+        for pair in ordered.windows(2) {
+            assert!(
+                Frozen32::new(pair[0]) < Frozen32::new(pair[1]),
+                "{} should order below {}",
+                pair[0],
+                pair[1],
+            );
+        }
+    }
+
+    #[test]
+    fn total_order_matches_numeric_order_f64() {
+        let ordered = [
+            f64::NEG_INFINITY,
+            f64::MIN,
+            -1.0,
+            -f64::MIN_POSITIVE,
+            -0.0,
+            0.0,
+            f64::MIN_POSITIVE,
+            1.0,
+            f64::MAX,
+            f64::INFINITY,
+        ];
+        for pair in ordered.windows(2) {
+            assert!(
+                Frozen64::new(pair[0]) < Frozen64::new(pair[1]),
+                "{} should order below {}",
+                pair[0],
+                pair[1],
+            );
+        }
+    }
+
+    #[test]
+    fn zero_signs_are_distinct() {
+        assert!(Frozen32::new(-0.0) < Frozen32::new(0.0));
+        assert_ne!(Frozen32::new(-0.0), Frozen32::new(0.0));
+        assert!(Frozen64::new(-0.0) < Frozen64::new(0.0));
+        assert_ne!(Frozen64::new(-0.0), Frozen64::new(0.0));
+    }
+
+    #[test]
+    fn nans_order_at_the_ends() {
+        // IEEE 754 totalOrder places negative NaNs below every number and positive NaNs
+        // above; the contract excludes NaN, but the sort in `crate::slice` must still
+        // terminate with a consistent order if one sneaks in
+        let pos_nan = Frozen32::new(f32::from_bits(0x7fc0_0000));
+        let neg_nan = Frozen32::new(f32::from_bits(0xffc0_0000));
+        assert!(neg_nan < Frozen32::new(f32::NEG_INFINITY));
+        assert!(pos_nan > Frozen32::new(f32::INFINITY));
+        assert_eq!(pos_nan, pos_nan);
+        assert_ne!(pos_nan, neg_nan);
+
+        let pos_nan = Frozen64::new(f64::from_bits(0x7ff8_0000_0000_0000));
+        let neg_nan = Frozen64::new(f64::from_bits(0xfff8_0000_0000_0000));
+        assert!(neg_nan < Frozen64::new(f64::NEG_INFINITY));
+        assert!(pos_nan > Frozen64::new(f64::INFINITY));
+    }
+
+    #[test]
+    fn sort_matches_primitive_sort() {
+        // no duplicate keys (and only one zero), so the unstable sorts have a unique answer
+        let mut values = [3.5f32, 2.0, -7.25, 0.0, 0.5, -2.0, 1e-40, 6e8, -1e-40];
+        let mut frozen: Vec<Frozen32> = values.iter().copied().map(Frozen32::new).collect();
+        frozen.sort_unstable();
+        values.sort_unstable_by(|a, b| a.partial_cmp(b).unwrap());
+        for (frozen, value) in frozen.iter().zip(&values) {
+            assert_eq!(frozen.get().to_bits(), value.to_bits());
+        }
+    }
+}
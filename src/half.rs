@@ -0,0 +1,365 @@
+//! Half-width storage types for bandwidth-bound data.
+//!
+//! Large-batch workloads are often limited by bytes moved rather than arithmetic; for data
+//! with few significant digits, storing buffers at 16 bits per element and widening to
+//! [`FF32`](crate::FF32) for compute halves the memory traffic. The types here are storage
+//! only -- they carry no arithmetic of their own -- and the hot widening direction is a
+//! vectorized bulk decode kernel.
+
+use crate::FF32;
+use core::fmt;
+
+// scalar conversions, shared with the fallback backend shims
+
+#[inline(always)]
+pub(crate) fn f16_to_f32(bits: u16) -> f32 {
+    // same magic-multiply widening as the bulk kernel: shifting the half's exponent and
+    // mantissa into f32 position leaves the exponent biased 112 too low; multiplying by
+    // 2^112 (0x7780_0000) fixes it with an exact float op and also normalizes subnormal
+    // halves
+    let magnitude =
+        f32::from_bits(((bits & 0x7fff) as u32) << 13) * f32::from_bits(0x7780_0000);
+    f32::from_bits((((bits & 0x8000) as u32) << 16) | magnitude.to_bits())
+}
+
+#[inline]
+pub(crate) fn f32_to_f16(value: f32) -> u16 {
+    let bits = value.to_bits();
+    let sign = ((bits >> 16) & 0x8000) as u16;
+    let abs = bits & 0x7fff_ffff;
+
+    if abs >= 0x477f_f000 {
+        // saturates to infinity; non-finite values are outside the crate's contract anyway
+        return sign | 0x7c00;
+    }
+    if abs >= 0x3880_0000 {
+        // normal result: round the 13 dropped mantissa bits to nearest even, then rebias
+        // the exponent from 127 to 15. A rounding carry into the exponent is handled by the
+        // plain integer add
+        let rounded = abs + 0xfff + ((abs >> 13) & 1);
+        return sign | ((rounded - 0x3800_0000) >> 13) as u16;
+    }
+
+    // subnormal (or zero) result: shift the significand with its implicit bit into place
+    let exp = abs >> 23;
+    if exp < 102 {
+        // below half the smallest subnormal, rounds to zero
+        return sign;
+    }
+    let mant = (abs & 0x7f_ffff) | 0x80_0000;
+    let shift = 126 - exp;
+    let half_bit = 1u32 << (shift - 1);
+    let rem = mant & ((1u32 << shift) - 1);
+    let mut out = mant >> shift;
+    if rem > half_bit || (rem == half_bit && out & 1 == 1) {
+        out += 1;
+    }
+    sign | out as u16
+}
+
+#[inline(always)]
+pub(crate) fn bf16_to_f32(bits: u16) -> f32 {
+    // bfloat16 is just the top half of an f32
+    f32::from_bits((bits as u32) << 16)
+}
+
+#[inline]
+pub(crate) fn f32_to_bf16(value: f32) -> u16 {
+    let bits = value.to_bits();
+    // round the 16 dropped bits to nearest even
+    let rounded = bits + 0x7fff + ((bits >> 16) & 1);
+    (rounded >> 16) as u16
+}
+
+macro_rules! impl_half {
+    ($(
+        $(#[$attr:meta])*
+        $half_ty:ident, $suffix:ident, $to_f32:ident, $from_f32:ident, $decode_kernel:ident;
+    )*) => {
+        $(
+            $(#[$attr])*
+            ///
+            /// This is a storage type: it carries no arithmetic. Convert to
+            /// [`FF32`](crate::FF32) (preferably in bulk with
+            #[doc = concat!("[`decode_slice`](", stringify!($half_ty), "::decode_slice))")]
+            /// for compute. Values are subject to the same finite-math restrictions as the
+            /// fast types
+            #[derive(Clone, Copy)]
+            #[repr(transparent)]
+            pub struct $half_ty(u16);
+
+            #[cfg(not(feature = "fallback"))]
+            #[link(name = "poison_safe")]
+            extern "C" {
+                fn $decode_kernel(src: *const u16, dst: *mut FF32, n: usize);
+            }
+
+            #[cfg(feature = "fallback")]
+            unsafe fn $decode_kernel(src: *const u16, dst: *mut FF32, n: usize) {
+                for i in 0..n {
+                    *dst.add(i) = FF32::new($to_f32(*src.add(i)));
+                }
+            }
+
+            impl $half_ty {
+                #[doc = "Encode an `f32` into a `"]
+                #[doc = stringify!($half_ty)]
+                #[doc = "`, rounding to nearest even."]
+                ///
+                /// Values too large for the format saturate to infinity, which like all
+                /// non-finite values is outside this crate's contract
+                #[inline]
+                pub fn from_f32(value: f32) -> Self {
+                    $half_ty($from_f32(value))
+                }
+
+                /// Decode back to an `f32`
+                #[inline]
+                pub fn to_f32(self) -> f32 {
+                    $to_f32(self.0)
+                }
+
+                /// The raw storage bits
+                #[inline(always)]
+                pub const fn to_bits(self) -> u16 {
+                    self.0
+                }
+
+                /// Reconstruct from raw storage bits
+                #[inline(always)]
+                pub const fn from_bits(bits: u16) -> Self {
+                    $half_ty(bits)
+                }
+
+                /// Widen a whole buffer into `out`, through one vectorized kernel call.
+                ///
+                /// # Panics
+                ///
+                /// Panics if `src` and `out` have different lengths
+                #[inline]
+                pub fn decode_slice(src: &[Self], out: &mut [FF32]) {
+                    assert_eq!(src.len(), out.len());
+                    // the half type is repr(transparent) over its storage bits
+                    unsafe {
+                        $decode_kernel(src.as_ptr() as *const u16, out.as_mut_ptr(), src.len())
+                    }
+                }
+
+                /// Widen a whole buffer into a new `Vec`, through one vectorized kernel call
+                pub fn decode(src: &[Self]) -> Vec<FF32> {
+                    let mut out = Vec::with_capacity(src.len());
+                    unsafe {
+                        $decode_kernel(src.as_ptr() as *const u16, out.as_mut_ptr(), src.len());
+                        // the kernel initialized every element
+                        out.set_len(src.len());
+                    }
+                    out
+                }
+
+                /// Encode a buffer of primitives, narrowing each element.
+                ///
+                /// Encoding is the cold direction (ingest, not compute), so this is a plain
+                /// scalar loop
+                ///
+                /// # Panics
+                ///
+                /// Panics if `src` and `out` have different lengths
+                pub fn encode_slice(src: &[f32], out: &mut [Self]) {
+                    assert_eq!(src.len(), out.len());
+                    for (dst, &value) in out.iter_mut().zip(src) {
+                        *dst = Self::from_f32(value);
+                    }
+                }
+            }
+
+            impl From<f32> for $half_ty {
+                #[inline]
+                fn from(from: f32) -> Self {
+                    Self::from_f32(from)
+                }
+            }
+
+            impl From<$half_ty> for f32 {
+                #[inline]
+                fn from(from: $half_ty) -> Self {
+                    from.to_f32()
+                }
+            }
+
+            impl From<$half_ty> for FF32 {
+                #[inline]
+                fn from(from: $half_ty) -> Self {
+                    FF32::new(from.to_f32())
+                }
+            }
+
+            impl From<FF32> for $half_ty {
+                #[inline]
+                fn from(from: FF32) -> Self {
+                    Self::from_f32(from.freeze_raw())
+                }
+            }
+
+            // comparing decoded values rather than bits, so +0 == -0 as with the primitives
+            impl PartialEq for $half_ty {
+                #[inline]
+                fn eq(&self, other: &Self) -> bool {
+                    self.to_f32() == other.to_f32()
+                }
+            }
+
+            impl fmt::Debug for $half_ty {
+                fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                    <f32 as fmt::Debug>::fmt(&self.to_f32(), f)
+                }
+            }
+
+            impl fmt::Display for $half_ty {
+                fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                    <f32 as fmt::Display>::fmt(&self.to_f32(), f)
+                }
+            }
+        )*
+    };
+}
+
+impl_half! {
+    /// An IEEE 754 binary16 value, stored at half the width of an `f32`.
+    FF16, f16, f16_to_f32, f32_to_f16, decode_slice_f16;
+
+    /// A bfloat16 value: the top 16 bits of an `f32`, trading mantissa for `f32`'s full
+    /// exponent range.
+    FFBF16, bf16, bf16_to_f32, f32_to_bf16, decode_slice_bf16;
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    // the scalar conversions are pure bit manipulation, so they are exhaustively testable
+    // over all 2^16 storage patterns without the C kernels (and under --features fallback)
+
+    #[test]
+    fn f16_decodes_known_values() {
+        assert_eq!(f16_to_f32(0x0000), 0.0);
+        assert_eq!(f16_to_f32(0x8000).to_bits(), (-0.0f32).to_bits());
+        assert_eq!(f16_to_f32(0x3c00), 1.0);
+        assert_eq!(f16_to_f32(0xc000), -2.0);
+        assert_eq!(f16_to_f32(0x3555), 0.333251953125); // closest binary16 to 1/3
+        assert_eq!(f16_to_f32(0x7bff), 65504.0); // largest finite binary16
+        assert_eq!(f16_to_f32(0x0400), 2f32.powi(-14)); // smallest normal
+        assert_eq!(f16_to_f32(0x0001), 2f32.powi(-24)); // smallest subnormal
+        assert_eq!(f16_to_f32(0x03ff), 1023.0 * 2f32.powi(-24)); // largest subnormal
+        assert_eq!(f16_to_f32(0x8001), -(2f32.powi(-24)));
+        // the branch-free magic multiply does not special-case the non-finite encodings
+        // (they are outside the crate's contract): the infinities widen to +/-65536, one
+        // step past the largest finite binary16, and still re-encode to themselves
+        assert_eq!(f16_to_f32(0x7c00), 65536.0);
+        assert_eq!(f16_to_f32(0xfc00), -65536.0);
+    }
+
+    #[test]
+    fn f16_round_trips_every_non_nan_pattern() {
+        for bits in 0..=u16::MAX {
+            if bits & 0x7c00 == 0x7c00 && bits & 0x03ff != 0 {
+                // NaN payloads are not preserved; like every non-finite value they are
+                // outside the crate's contract
+                continue;
+            }
+            let decoded = f16_to_f32(bits);
+            assert_eq!(
+                f32_to_f16(decoded),
+                bits,
+                "bits {:#06x} decoded to {} but re-encoded differently",
+                bits,
+                decoded,
+            );
+        }
+    }
+
+    #[test]
+    fn f16_encode_rounds_ties_to_even() {
+        let ulp = 2f32.powi(-10); // spacing of binary16 at 1.0
+        assert_eq!(f32_to_f16(1.0 + 0.5 * ulp), 0x3c00); // tie rounds down to even
+        assert_eq!(f32_to_f16(f32::from_bits(0x3f80_1001)), 0x3c01); // one f32 ulp above
+        assert_eq!(f32_to_f16(1.0 + 1.5 * ulp), 0x3c02); // tie rounds up to even
+        assert_eq!(f32_to_f16(-(1.0 + 1.5 * ulp)), 0xbc02);
+        // a rounding carry that overflows the mantissa must bump the exponent
+        assert_eq!(f32_to_f16(2.0 - 0.5 * ulp), 0x4000);
+    }
+
+    #[test]
+    fn f16_encode_subnormals() {
+        let sub = 2f32.powi(-24); // smallest binary16 subnormal
+        assert_eq!(f32_to_f16(sub), 0x0001);
+        assert_eq!(f32_to_f16(0.5 * sub), 0x0000); // tie with zero rounds to even
+        assert_eq!(f32_to_f16(0.75 * sub), 0x0001);
+        assert_eq!(f32_to_f16(1.5 * sub), 0x0002); // tie rounds up to even
+        assert_eq!(f32_to_f16(2.5 * sub), 0x0002); // tie rounds down to even
+        assert_eq!(f32_to_f16(-0.75 * sub), 0x8001);
+        // largest subnormal, and the boundary where the result turns normal
+        assert_eq!(f32_to_f16(1023.0 * sub), 0x03ff);
+        assert_eq!(f32_to_f16(2f32.powi(-14)), 0x0400);
+    }
+
+    #[test]
+    fn f16_encode_saturates() {
+        assert_eq!(f32_to_f16(65504.0), 0x7bff);
+        // 65520 is the tie between the largest finite value and the (overflowing) next
+        // step, so it rounds away to infinity
+        assert_eq!(f32_to_f16(65519.0), 0x7bff);
+        assert_eq!(f32_to_f16(65520.0), 0x7c00);
+        assert_eq!(f32_to_f16(f32::MAX), 0x7c00);
+        assert_eq!(f32_to_f16(-f32::MAX), 0xfc00);
+    }
+
+    #[test]
+    fn bf16_decodes_known_values() {
+        assert_eq!(bf16_to_f32(0x0000), 0.0);
+        assert_eq!(bf16_to_f32(0x8000).to_bits(), (-0.0f32).to_bits());
+        assert_eq!(bf16_to_f32(0x3f80), 1.0);
+        assert_eq!(bf16_to_f32(0xc2f7), -123.5);
+        assert_eq!(bf16_to_f32(0x7f80), f32::INFINITY);
+        assert_eq!(bf16_to_f32(0xff80), f32::NEG_INFINITY);
+    }
+
+    #[test]
+    fn bf16_round_trips_every_pattern() {
+        // the widened f32 has zero low bits, so re-encoding never carries and every
+        // pattern -- including NaN payloads -- must survive
+        for bits in 0..=u16::MAX {
+            assert_eq!(f32_to_bf16(bf16_to_f32(bits)), bits, "bits {:#06x}", bits);
+        }
+    }
+
+    #[test]
+    fn bf16_encode_rounds_ties_to_even() {
+        assert_eq!(f32_to_bf16(f32::from_bits(0x3f80_8000)), 0x3f80); // tie down to even
+        assert_eq!(f32_to_bf16(f32::from_bits(0x3f80_8001)), 0x3f81); // just above
+        assert_eq!(f32_to_bf16(f32::from_bits(0x3f81_8000)), 0x3f82); // tie up to even
+        // rounding f32::MAX carries all the way into the exponent, overflowing to infinity
+        assert_eq!(f32_to_bf16(f32::MAX), 0x7f80);
+    }
+
+    #[test]
+    fn slice_codecs_round_trip() {
+        let values = [0.0f32, -0.0, 1.0, -2.5, 0.15625, 6e4];
+
+        let mut encoded = [FF16::from_bits(0); 6];
+        FF16::encode_slice(&values, &mut encoded);
+        let mut decoded = [crate::ff32(0.0); 6];
+        FF16::decode_slice(&encoded, &mut decoded);
+        for (decoded, &value) in decoded.iter().zip(&values) {
+            // every input is exactly representable except 6e4, which rounds to a nearby
+            // binary16
+            assert!((f32::from(*decoded) - value).abs() <= 32.0);
+        }
+        assert_eq!(f32::from(decoded[4]), 0.15625);
+
+        let mut encoded = [FFBF16::from_bits(0); 6];
+        FFBF16::encode_slice(&values, &mut encoded);
+        let decoded = FFBF16::decode(&encoded);
+        assert_eq!(f32::from(decoded[3]), -2.5);
+        assert_eq!(f32::from(decoded[4]), 0.15625);
+    }
+}
@@ -38,13 +38,36 @@ macro_rules! forward_freeze_self {
     };
 }
 
+mod bytemuck;
 mod math;
 mod nalgebra;
+#[cfg(feature = "nalgebra-v029")]
+pub use crate::nalgebra::nalgebra_v029::{FastNorm, FastSum};
 mod num_traits;
 
+pub mod diagnostics;
+pub mod expr;
+pub mod linalg;
+pub mod parallel;
+pub mod profiling;
+pub mod slice;
+pub mod soa;
+
+mod frozen;
+pub use frozen::{Frozen32, Frozen64};
+
+mod half;
+pub use crate::half::{FFBF16, FF16};
+
 mod poison;
 use poison::MaybePoison;
 
+mod wide;
+pub use wide::{FF32x4, FF32x8, FF64x2, FF64x4};
+
+mod assoc;
+pub use crate::assoc::{af32, af64, AF32, AF64};
+
 // The big challenge with fast-math in general is avoiding UB, and to a lesser extent unspecified
 // values. LLVM's fast operations document "poison" behavior when given invalid inputs; poison
 // values have a relatively consistent behavior (stuff like transitivity), defined cases for UB,
@@ -124,9 +147,14 @@ pub struct FF32(MaybePoison<f32>);
 ///
 /// The given value **MUST NOT** be infinite or NaN, and any operations involving this value must
 /// not produce infinite or NaN results. The output of any such operation is unspecified.
+///
+/// With the `diagnostics` feature enabled, values passing through here are sample-checked for
+/// finite-math violations
 #[inline(always)]
+#[cfg_attr(feature = "diagnostics", track_caller)]
 pub fn ff32(f: f32) -> FF32 {
-    // TODO maybe a feature flag to make this checked -> panic?
+    #[cfg(feature = "diagnostics")]
+    crate::diagnostics::sample(f);
     FF32::new(f)
 }
 
@@ -142,9 +170,14 @@ pub struct FF64(MaybePoison<f64>);
 ///
 /// The given value **MUST NOT** be infinite or NaN, and any operations involving this value must
 /// not produce infinite or NaN results. The output of any such operation is unspecified.
+///
+/// With the `diagnostics` feature enabled, values passing through here are sample-checked for
+/// finite-math violations
 #[inline(always)]
+#[cfg_attr(feature = "diagnostics", track_caller)]
 pub fn ff64(f: f64) -> FF64 {
-    // TODO maybe a feature flag to make this checked -> panic?
+    #[cfg(feature = "diagnostics")]
+    crate::diagnostics::sample(f);
     FF64::new(f)
 }
 
@@ -282,7 +315,89 @@ macro_rules! impls {
 
             #[inline(always)]
             fn freeze_raw(self) -> $base_ty {
-                self.0.freeze()
+                let raw = self.0.freeze();
+                // a non-finite frozen value means some earlier operation violated the
+                // finite-math contract; sample-record it at the first boundary where the
+                // concrete bits are visible
+                #[cfg(feature = "diagnostics")]
+                crate::diagnostics::sample(raw);
+                raw
+            }
+
+            #[doc = "View a slice of primitives as a slice of `"]
+            #[doc = stringify!($fast_ty)]
+            #[doc = "`, without copying."]
+            ///
+            /// The fast type is (transitively) `repr(transparent)` over the primitive, so the
+            /// buffer can be reused as-is -- useful for e.g. memory-mapped data. The values are
+            /// subject to the same restrictions as [`new`](Self::new)
+            #[inline]
+            pub fn from_slice(slice: &[$base_ty]) -> &[$fast_ty] {
+                unsafe { &*(slice as *const [$base_ty] as *const [$fast_ty]) }
+            }
+
+            #[doc = "Run a closure over a mutable slice of primitives viewed as a mutable slice of `"]
+            #[doc = stringify!($fast_ty)]
+            #[doc = "`, without copying."]
+            ///
+            /// Operations through the view may store poison values into the borrowed buffer,
+            /// which must not be observable by the owner once the borrow ends. Every element is
+            /// therefore frozen (one vectorized pass) when the closure returns -- including by
+            /// panic -- the same boundary `From<FF32> for f32` applies per value. Scoping the
+            /// view to a closure guarantees the freeze runs; a guard value returned to the
+            /// caller could be leaked past its destructor
+            #[inline]
+            pub fn with_slice_mut<R>(
+                slice: &mut [$base_ty],
+                f: impl FnOnce(&mut [$fast_ty]) -> R,
+            ) -> R {
+                struct FreezeOnExit<'a>(&'a mut [$fast_ty]);
+
+                impl Drop for FreezeOnExit<'_> {
+                    #[inline]
+                    fn drop(&mut self) {
+                        crate::slice::freeze_in_place(self.0);
+                    }
+                }
+
+                let mut guard = FreezeOnExit(unsafe {
+                    &mut *(slice as *mut [$base_ty] as *mut [$fast_ty])
+                });
+                f(&mut *guard.0)
+            }
+
+            #[doc = "Convert a vec of primitives into a vec of `"]
+            #[doc = stringify!($fast_ty)]
+            #[doc = "`, reusing the allocation."]
+            ///
+            /// The values are subject to the same restrictions as [`new`](Self::new)
+            #[inline]
+            pub fn from_vec(vec: Vec<$base_ty>) -> Vec<$fast_ty> {
+                let mut vec = core::mem::ManuallyDrop::new(vec);
+                unsafe {
+                    Vec::from_raw_parts(
+                        vec.as_mut_ptr() as *mut $fast_ty,
+                        vec.len(),
+                        vec.capacity(),
+                    )
+                }
+            }
+
+            /// Convert a vec of fast values back into primitives, reusing the allocation.
+            ///
+            /// The values leave this crate's poison management, so every element is frozen --
+            /// but in one vectorized pass rather than per value
+            #[inline]
+            pub fn into_vec(mut vec: Vec<$fast_ty>) -> Vec<$base_ty> {
+                crate::slice::freeze_in_place(&mut vec);
+                let mut vec = core::mem::ManuallyDrop::new(vec);
+                unsafe {
+                    Vec::from_raw_parts(
+                        vec.as_mut_ptr() as *mut $base_ty,
+                        vec.len(),
+                        vec.capacity(),
+                    )
+                }
             }
 
             forward_freeze_self! {
@@ -350,16 +465,6 @@ macro_rules! impls {
             pub fn log(self, base: Self) -> Self {
                 self.ln() / base.ln()
             }
-
-            #[inline]
-            pub fn mul_add(self, mul: Self, add: Self) -> Self {
-                self * mul + add
-            }
-
-            #[inline]
-            pub fn sin_cos(self) -> (Self, Self) {
-                (self.sin(), self.cos())
-            }
         }
 
         impl_fmt! {
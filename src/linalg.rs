@@ -0,0 +1,182 @@
+//! Dense linear algebra micro-kernels over the fast types.
+//!
+//! Generic scalar code (e.g. nalgebra's loops over the `Add`/`Mul` impls) leaves the inner
+//! loops of small matrix products unblocked and unfused. The kernels here keep the whole
+//! operation inside one fast-math compiled function, where reassociation makes register
+//! blocking and vector FMA legal. Matrices are dense and row-major.
+//!
+//! The const-generic variants take nested-array references, so the dimensions are part of the
+//! type; once LTO inlines the kernel, constant trip counts let the small fixed sizes unroll
+//! completely.
+
+use crate::slice::SliceOps;
+use crate::{FF32, FF64};
+use paste::paste;
+
+#[cfg(feature = "fallback")]
+use crate::math::fallback::*;
+
+/// A scalar fast type usable with the kernels in this module.
+///
+/// Implemented only by [`FF32`] and [`FF64`]; the methods are an implementation detail of the
+/// module-level functions
+pub trait LinalgOps: SliceOps {
+    #[doc(hidden)]
+    fn axpy_slice(alpha: Self, x: &[Self], y: &mut [Self]);
+    #[doc(hidden)]
+    fn scale_slice(alpha: Self, x: &mut [Self]);
+    #[doc(hidden)]
+    unsafe fn gemv_raw(a: *const Self, x: *const Self, y: *mut Self, m: usize, n: usize);
+    #[doc(hidden)]
+    unsafe fn gemm_raw(
+        a: *const Self,
+        b: *const Self,
+        c: *mut Self,
+        m: usize,
+        k: usize,
+        n: usize,
+    );
+}
+
+macro_rules! impl_linalg_ops {
+    ($fast_ty:ident, $base_ty:ident) => {
+        paste! {
+            #[cfg(not(feature = "fallback"))]
+            #[link(name = "poison_safe")]
+            extern "C" {
+                // like the other poison safe kernels, these can accept (and may produce)
+                // poison values without UB
+                fn [<axpy_ $base_ty>](alpha: $fast_ty, x: *const $fast_ty, y: *mut $fast_ty, n: usize);
+                fn [<scale_slice_ $base_ty>](alpha: $fast_ty, x: *mut $fast_ty, n: usize);
+                fn [<gemv_ $base_ty>](
+                    a: *const $fast_ty,
+                    x: *const $fast_ty,
+                    y: *mut $fast_ty,
+                    m: usize,
+                    n: usize,
+                );
+                fn [<gemm_ $base_ty>](
+                    a: *const $fast_ty,
+                    b: *const $fast_ty,
+                    c: *mut $fast_ty,
+                    m: usize,
+                    k: usize,
+                    n: usize,
+                );
+            }
+
+            impl LinalgOps for $fast_ty {
+                #[inline]
+                fn axpy_slice(alpha: Self, x: &[Self], y: &mut [Self]) {
+                    unsafe { [<axpy_ $base_ty>](alpha, x.as_ptr(), y.as_mut_ptr(), x.len()) }
+                }
+
+                #[inline]
+                fn scale_slice(alpha: Self, x: &mut [Self]) {
+                    unsafe { [<scale_slice_ $base_ty>](alpha, x.as_mut_ptr(), x.len()) }
+                }
+
+                #[inline]
+                unsafe fn gemv_raw(a: *const Self, x: *const Self, y: *mut Self, m: usize, n: usize) {
+                    [<gemv_ $base_ty>](a, x, y, m, n)
+                }
+
+                #[inline]
+                unsafe fn gemm_raw(
+                    a: *const Self,
+                    b: *const Self,
+                    c: *mut Self,
+                    m: usize,
+                    k: usize,
+                    n: usize,
+                ) {
+                    [<gemm_ $base_ty>](a, b, c, m, k, n)
+                }
+            }
+        }
+    };
+}
+
+impl_linalg_ops! { FF32, f32 }
+impl_linalg_ops! { FF64, f64 }
+
+pub use crate::slice::dot;
+
+/// `y += alpha * x`, as one fused kernel over the buffers.
+///
+/// # Panics
+///
+/// Panics if `x` and `y` have different lengths
+#[inline]
+pub fn axpy<T: LinalgOps>(alpha: T, x: &[T], y: &mut [T]) {
+    assert_eq!(x.len(), y.len());
+    T::axpy_slice(alpha, x, y);
+}
+
+/// `x *= alpha` in place
+#[inline]
+pub fn scale_inplace<T: LinalgOps>(alpha: T, x: &mut [T]) {
+    T::scale_slice(alpha, x);
+}
+
+/// `y = a * x` for a dense row-major `m x n` matrix `a`, where `m = y.len()` and
+/// `n = x.len()`.
+///
+/// # Panics
+///
+/// Panics if `a.len() != y.len() * x.len()`
+#[inline]
+pub fn gemv<T: LinalgOps>(a: &[T], x: &[T], y: &mut [T]) {
+    let (m, n) = (y.len(), x.len());
+    assert_eq!(a.len(), m * n);
+    unsafe { T::gemv_raw(a.as_ptr(), x.as_ptr(), y.as_mut_ptr(), m, n) }
+}
+
+/// `c = a * b` for dense row-major matrices: `a` is `m x k`, `b` is `k x n` and `c` is
+/// `m x n`.
+///
+/// # Panics
+///
+/// Panics if the slice lengths are inconsistent with `m`, `k` and `n`
+#[inline]
+pub fn gemm<T: LinalgOps>(a: &[T], b: &[T], c: &mut [T], m: usize, k: usize, n: usize) {
+    assert_eq!(a.len(), m * k);
+    assert_eq!(b.len(), k * n);
+    assert_eq!(c.len(), m * n);
+    unsafe { T::gemm_raw(a.as_ptr(), b.as_ptr(), c.as_mut_ptr(), m, k, n) }
+}
+
+/// [`gemv`] with the dimensions fixed at compile time as nested arrays.
+///
+/// The constant trip counts let the kernel's loops fully unroll after LTO inlining, which is
+/// what small fixed-size hot loops (Kalman-filter sized matrices) want
+#[inline(always)]
+pub fn gemv_const<T: LinalgOps, const M: usize, const N: usize>(
+    a: &[[T; N]; M],
+    x: &[T; N],
+    y: &mut [T; M],
+) {
+    // nested arrays are contiguous, so the rows can be passed as one dense buffer
+    unsafe { T::gemv_raw(a.as_ptr() as *const T, x.as_ptr(), y.as_mut_ptr(), M, N) }
+}
+
+/// [`gemm`] with the dimensions fixed at compile time as nested arrays.
+///
+/// See [`gemv_const`] for why the const dimensions matter
+#[inline(always)]
+pub fn gemm_const<T: LinalgOps, const M: usize, const K: usize, const N: usize>(
+    a: &[[T; K]; M],
+    b: &[[T; N]; K],
+    c: &mut [[T; N]; M],
+) {
+    unsafe {
+        T::gemm_raw(
+            a.as_ptr() as *const T,
+            b.as_ptr() as *const T,
+            c.as_mut_ptr() as *mut T,
+            M,
+            K,
+            N,
+        )
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Kernels for the reassociation-only policy types (AF32/AF64). build.rs
+ * compiles this file with -fassociative-math (plus the -fno-signed-zeros and
+ * -fno-trapping-math flags clang requires for it to take effect),
+ * -ffp-contract=fast and -fno-math-errno -- but neither -ffinite-math-only
+ * nor -freciprocal-math. Nothing in that flag set can introduce poison: NaN
+ * and infinity remain ordinary IEEE values. So unlike the poison_safe /
+ * poison_unsafe split there is only one group here, and the rust side needs
+ * no freezing at all.
+ */
+
+#include <stddef.h>
+
+#define IMPL_ASSOC_OPERATIONS(C_TYPE, RUST_TYPE, FMA_FN)       \
+  __attribute__((always_inline))                               \
+  C_TYPE add_assoc_ ## RUST_TYPE(C_TYPE a, C_TYPE b) {         \
+    return a + b;                                              \
+  }                                                            \
+                                                               \
+  __attribute__((always_inline))                               \
+  C_TYPE sub_assoc_ ## RUST_TYPE(C_TYPE a, C_TYPE b) {         \
+    return a - b;                                              \
+  }                                                            \
+                                                               \
+  __attribute__((always_inline))                               \
+  C_TYPE mul_assoc_ ## RUST_TYPE(C_TYPE a, C_TYPE b) {         \
+    return a * b;                                              \
+  }                                                            \
+                                                               \
+  __attribute__((always_inline))                               \
+  C_TYPE div_assoc_ ## RUST_TYPE(C_TYPE a, C_TYPE b) {         \
+    return a / b;                                              \
+  }                                                            \
+                                                               \
+  __attribute__((always_inline))                               \
+  C_TYPE neg_assoc_ ## RUST_TYPE(C_TYPE a) {                   \
+    return -a;                                                 \
+  }                                                            \
+                                                               \
+  __attribute__((always_inline))                               \
+  C_TYPE mul_add_assoc_ ## RUST_TYPE(C_TYPE a, C_TYPE b,       \
+                                     C_TYPE c) {               \
+    return FMA_FN(a, b, c);                                    \
+  }                                                            \
+
+IMPL_ASSOC_OPERATIONS(float, f32, __builtin_fmaf)
+IMPL_ASSOC_OPERATIONS(double, f64, __builtin_fma)
+
+/* same multiversioning scheme as the bulk kernels in poison_safe.c; see
+ * multiversion.h for the dispatch machinery */
+#include "multiversion.h"
+
+#define IMPL_ASSOC_REDUCTIONS(C_TYPE, RUST_TYPE)                               \
+  FF_MV_BODY                                                                   \
+  C_TYPE sum_slice_assoc_ ## RUST_TYPE ## _impl(const C_TYPE *p, size_t n) {   \
+    C_TYPE acc = 0;                                                            \
+    for (size_t i = 0; i < n; i++) {                                           \
+      acc += p[i];                                                             \
+    }                                                                          \
+    return acc;                                                                \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH(C_TYPE, sum_slice_assoc_ ## RUST_TYPE,                    \
+                     (const C_TYPE *p, size_t n), (p, n));                     \
+                                                                               \
+  FF_MV_BODY                                                                   \
+  C_TYPE dot_slice_assoc_ ## RUST_TYPE ## _impl(const C_TYPE *a,               \
+                                                const C_TYPE *b, size_t n) {   \
+    C_TYPE acc = 0;                                                            \
+    for (size_t i = 0; i < n; i++) {                                           \
+      acc += a[i] * b[i];                                                      \
+    }                                                                          \
+    return acc;                                                                \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH(C_TYPE, dot_slice_assoc_ ## RUST_TYPE,                    \
+                     (const C_TYPE *a, const C_TYPE *b, size_t n),             \
+                     (a, b, n));                                               \
+
+IMPL_ASSOC_REDUCTIONS(float, f32)
+IMPL_ASSOC_REDUCTIONS(double, f64)
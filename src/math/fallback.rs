@@ -0,0 +1,504 @@
+//! Pure-rust fallback implementations of the kernel symbols.
+//!
+//! Without `-Clinker-plugin-lto` and a matching clang, every kernel call is a real function
+//! call, which turns each arithmetic op into an FFI round trip. With the `fallback` feature
+//! the extern declarations throughout the crate are replaced by the ordinary rust functions
+//! in this module, with the same names and signatures. Operations then inline like any rust
+//! code, at plain IEEE semantics: the fast-math optimizations are lost, but performance
+//! degrades to "ordinary float math" instead of "call per operation".
+//!
+//! Because none of the fast-math compiled libraries are linked in this mode, no operation can
+//! ever produce an LLVM poison value, which is why freezing (see `crate::poison`) degrades to
+//! a plain read of the stored value.
+
+use crate::{FF32, FF32x4, FF32x8, FF64, FF64x2, FF64x4};
+use paste::paste;
+
+macro_rules! scalar_fallback {
+    ($fast_ty:ident, $base_ty:ident) => {
+        paste! {
+            pub(crate) unsafe fn [<add_ $base_ty>](a: $fast_ty, b: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(a.freeze_raw() + b.freeze_raw())
+            }
+
+            pub(crate) unsafe fn [<sub_ $base_ty>](a: $fast_ty, b: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(a.freeze_raw() - b.freeze_raw())
+            }
+
+            pub(crate) unsafe fn [<mul_ $base_ty>](a: $fast_ty, b: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(a.freeze_raw() * b.freeze_raw())
+            }
+
+            pub(crate) unsafe fn [<div_ $base_ty>](a: $fast_ty, b: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(a.freeze_raw() / b.freeze_raw())
+            }
+
+            pub(crate) unsafe fn [<neg_ $base_ty>](a: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(-a.freeze_raw())
+            }
+
+            pub(crate) unsafe fn [<abs_ $base_ty>](a: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(a.freeze_raw().abs())
+            }
+
+            pub(crate) unsafe fn [<copysign_ $base_ty>](a: $fast_ty, b: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(a.freeze_raw().copysign(b.freeze_raw()))
+            }
+
+            pub(crate) unsafe fn [<max_ $base_ty>](a: $fast_ty, b: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(a.freeze_raw().max(b.freeze_raw()))
+            }
+
+            pub(crate) unsafe fn [<min_ $base_ty>](a: $fast_ty, b: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(a.freeze_raw().min(b.freeze_raw()))
+            }
+
+            pub(crate) unsafe fn [<mul_add_ $base_ty>](
+                a: $fast_ty,
+                b: $fast_ty,
+                c: $fast_ty,
+            ) -> $fast_ty {
+                <$fast_ty>::new(a.freeze_raw().mul_add(b.freeze_raw(), c.freeze_raw()))
+            }
+
+            pub(crate) unsafe fn [<clamp_ $base_ty>](
+                a: $fast_ty,
+                min: $fast_ty,
+                max: $fast_ty,
+            ) -> $fast_ty {
+                // like the kernel, `min > max` gives an unspecified value rather than a panic
+                let mut v = a.freeze_raw();
+                let (min, max) = (min.freeze_raw(), max.freeze_raw());
+                if v < min {
+                    v = min;
+                }
+                if v > max {
+                    v = max;
+                }
+                <$fast_ty>::new(v)
+            }
+
+            pub(crate) unsafe fn [<powi_ $base_ty>](a: $fast_ty, b: i32) -> $fast_ty {
+                <$fast_ty>::new(a.freeze_raw().powi(b))
+            }
+
+            pub(crate) unsafe fn [<poly_eval_ $base_ty>](
+                coeffs: *const $fast_ty,
+                n: usize,
+                x: $fast_ty,
+            ) -> $fast_ty {
+                let coeffs = core::slice::from_raw_parts(coeffs, n);
+                let x = x.freeze_raw();
+                let mut acc = match coeffs.first() {
+                    Some(c) => c.freeze_raw(),
+                    None => 0.0,
+                };
+                for c in &coeffs[1.min(n)..] {
+                    acc = acc.mul_add(x, c.freeze_raw());
+                }
+                <$fast_ty>::new(acc)
+            }
+
+            pub(crate) unsafe fn [<approx_recip_ $base_ty>](a: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(1.0 / a.freeze_raw())
+            }
+
+            pub(crate) unsafe fn [<approx_recip_refined_ $base_ty>](a: $fast_ty) -> $fast_ty {
+                [<approx_recip_ $base_ty>](a)
+            }
+
+            pub(crate) unsafe fn [<approx_rsqrt_ $base_ty>](a: $fast_ty) -> $fast_ty {
+                <$fast_ty>::new(1.0 / a.freeze_raw().sqrt())
+            }
+
+            pub(crate) unsafe fn [<approx_rsqrt_refined_ $base_ty>](a: $fast_ty) -> $fast_ty {
+                [<approx_rsqrt_ $base_ty>](a)
+            }
+
+            pub(crate) unsafe fn [<rem_ $base_ty>](a: $base_ty, b: $base_ty) -> $fast_ty {
+                <$fast_ty>::new(a % b)
+            }
+
+            pub(crate) unsafe fn [<sin_cos_ $base_ty>](
+                a: $base_ty,
+                sin_out: *mut $base_ty,
+                cos_out: *mut $base_ty,
+            ) {
+                let (sin, cos) = a.sin_cos();
+                *sin_out = sin;
+                *cos_out = cos;
+            }
+        }
+    };
+}
+
+scalar_fallback! { FF32, f32 }
+scalar_fallback! { FF64, f64 }
+
+macro_rules! select_fallback {
+    ($fast_ty:ident, $base_ty:ident: $($fn:ident, $op:tt;)*) => {
+        paste! {
+            $(
+                pub(crate) unsafe fn [<$fn _ $base_ty>](
+                    a: $fast_ty,
+                    b: $fast_ty,
+                    if_true: $fast_ty,
+                    if_false: $fast_ty,
+                ) -> $fast_ty {
+                    if a.freeze_raw() $op b.freeze_raw() {
+                        if_true
+                    } else {
+                        if_false
+                    }
+                }
+            )*
+        }
+    };
+}
+
+select_fallback! { FF32, f32: select_ge, >=; select_gt, >; select_le, <=; select_lt, <; }
+select_fallback! { FF64, f64: select_ge, >=; select_gt, >; select_le, <=; select_lt, <; }
+
+// the libm forwards map one to one onto the std float methods of the same names
+macro_rules! unary_libm_fallback {
+    ($fast_ty:ident, $base_ty:ident: $($fn:ident,)*) => {
+        paste! {
+            $(
+                pub(crate) unsafe fn [<$fn _ $base_ty>](a: $base_ty) -> $fast_ty {
+                    <$fast_ty>::new(a.$fn())
+                }
+            )*
+        }
+    };
+}
+
+macro_rules! binary_libm_fallback {
+    ($fast_ty:ident, $base_ty:ident: $($fn:ident,)*) => {
+        paste! {
+            $(
+                pub(crate) unsafe fn [<$fn _ $base_ty>](a: $base_ty, b: $base_ty) -> $fast_ty {
+                    <$fast_ty>::new(a.$fn(b))
+                }
+            )*
+        }
+    };
+}
+
+macro_rules! libm_fallback {
+    ($fast_ty:ident, $base_ty:ident) => {
+        unary_libm_fallback! {
+            $fast_ty, $base_ty:
+            acos, acosh, asin, asinh, atan, atanh, cbrt, ceil, cos, cosh, exp, exp2, exp_m1,
+            floor, ln, ln_1p, log2, log10, round, sin, sinh, sqrt, tan, tanh, trunc,
+        }
+
+        binary_libm_fallback! {
+            $fast_ty, $base_ty:
+            atan2, powf,
+        }
+    };
+}
+
+libm_fallback! { FF32, f32 }
+libm_fallback! { FF64, f64 }
+
+macro_rules! wide_binary_fallback {
+    ($wide_ty:ident, $suffix:ident: $($fn:ident, $op:tt;)*) => {
+        paste! {
+            $(
+                pub(crate) unsafe fn [<$fn _ $suffix>](
+                    a: *const $wide_ty,
+                    b: *const $wide_ty,
+                    out: *mut $wide_ty,
+                ) {
+                    let (a, b) = ((*a).to_array(), (*b).to_array());
+                    let mut r = a;
+                    for i in 0..r.len() {
+                        r[i] = a[i] $op b[i];
+                    }
+                    *out = <$wide_ty>::new(r);
+                }
+            )*
+        }
+    };
+}
+
+macro_rules! wide_fallback {
+    ($wide_ty:ident, $suffix:ident) => {
+        paste! {
+            wide_binary_fallback! {
+                $wide_ty, $suffix:
+                add, +; sub, -; mul, *; div, /;
+            }
+
+            pub(crate) unsafe fn [<neg_ $suffix>](a: *const $wide_ty, out: *mut $wide_ty) {
+                let mut r = (*a).to_array();
+                for v in &mut r {
+                    *v = -*v;
+                }
+                *out = <$wide_ty>::new(r);
+            }
+
+            pub(crate) unsafe fn [<min_ $suffix>](
+                a: *const $wide_ty,
+                b: *const $wide_ty,
+                out: *mut $wide_ty,
+            ) {
+                let (a, b) = ((*a).to_array(), (*b).to_array());
+                let mut r = a;
+                for i in 0..r.len() {
+                    r[i] = if b[i] < a[i] { b[i] } else { a[i] };
+                }
+                *out = <$wide_ty>::new(r);
+            }
+
+            pub(crate) unsafe fn [<max_ $suffix>](
+                a: *const $wide_ty,
+                b: *const $wide_ty,
+                out: *mut $wide_ty,
+            ) {
+                let (a, b) = ((*a).to_array(), (*b).to_array());
+                let mut r = a;
+                for i in 0..r.len() {
+                    r[i] = if b[i] > a[i] { b[i] } else { a[i] };
+                }
+                *out = <$wide_ty>::new(r);
+            }
+
+            pub(crate) unsafe fn [<clamp_ $suffix>](
+                a: *const $wide_ty,
+                min: *const $wide_ty,
+                max: *const $wide_ty,
+                out: *mut $wide_ty,
+            ) {
+                let a = (*a).to_array();
+                let (min, max) = ((*min).to_array(), (*max).to_array());
+                let mut r = a;
+                for i in 0..r.len() {
+                    let mut v = a[i];
+                    if v < min[i] {
+                        v = min[i];
+                    }
+                    if v > max[i] {
+                        v = max[i];
+                    }
+                    r[i] = v;
+                }
+                *out = <$wide_ty>::new(r);
+            }
+        }
+    };
+}
+
+wide_fallback! { FF32x4, f32x4 }
+wide_fallback! { FF32x8, f32x8 }
+wide_fallback! { FF64x2, f64x2 }
+wide_fallback! { FF64x4, f64x4 }
+
+macro_rules! slice_fallback {
+    ($fast_ty:ident, $base_ty:ident) => {
+        paste! {
+            pub(crate) unsafe fn [<sum_slice_ $base_ty>](
+                ptr: *const $fast_ty,
+                len: usize,
+            ) -> $fast_ty {
+                let values = core::slice::from_raw_parts(ptr, len);
+                let mut acc = 0.0;
+                for v in values {
+                    acc += v.freeze_raw();
+                }
+                <$fast_ty>::new(acc)
+            }
+
+            pub(crate) unsafe fn [<product_slice_ $base_ty>](
+                ptr: *const $fast_ty,
+                len: usize,
+            ) -> $fast_ty {
+                let values = core::slice::from_raw_parts(ptr, len);
+                let mut acc = 1.0;
+                for v in values {
+                    acc *= v.freeze_raw();
+                }
+                <$fast_ty>::new(acc)
+            }
+
+            pub(crate) unsafe fn [<dot_slice_ $base_ty>](
+                a: *const $fast_ty,
+                b: *const $fast_ty,
+                len: usize,
+            ) -> $fast_ty {
+                let a = core::slice::from_raw_parts(a, len);
+                let b = core::slice::from_raw_parts(b, len);
+                let mut acc = 0.0;
+                for i in 0..len {
+                    acc = a[i].freeze_raw().mul_add(b[i].freeze_raw(), acc);
+                }
+                <$fast_ty>::new(acc)
+            }
+
+            // like the kernels, these assume len >= 1 (enforced by the rust callers)
+            pub(crate) unsafe fn [<min_slice_ $base_ty>](
+                ptr: *const $fast_ty,
+                len: usize,
+            ) -> $fast_ty {
+                let values = core::slice::from_raw_parts(ptr, len);
+                let mut acc = values[0].freeze_raw();
+                for v in &values[1..] {
+                    let v = v.freeze_raw();
+                    if v < acc {
+                        acc = v;
+                    }
+                }
+                <$fast_ty>::new(acc)
+            }
+
+            pub(crate) unsafe fn [<max_slice_ $base_ty>](
+                ptr: *const $fast_ty,
+                len: usize,
+            ) -> $fast_ty {
+                let values = core::slice::from_raw_parts(ptr, len);
+                let mut acc = values[0].freeze_raw();
+                for v in &values[1..] {
+                    let v = v.freeze_raw();
+                    if v > acc {
+                        acc = v;
+                    }
+                }
+                <$fast_ty>::new(acc)
+            }
+
+            pub(crate) unsafe fn [<poly_eval_slice_ $base_ty>](
+                coeffs: *const $fast_ty,
+                n: usize,
+                xs: *const $fast_ty,
+                out: *mut $fast_ty,
+                len: usize,
+            ) {
+                let xs = core::slice::from_raw_parts(xs, len);
+                let out = core::slice::from_raw_parts_mut(out, len);
+                for i in 0..len {
+                    out[i] = [<poly_eval_ $base_ty>](coeffs, n, xs[i]);
+                }
+            }
+
+            pub(crate) unsafe fn [<prefix_sum_slice_ $base_ty>](
+                ptr: *mut $fast_ty,
+                len: usize,
+            ) {
+                let values = core::slice::from_raw_parts_mut(ptr, len);
+                let mut carry = 0.0;
+                for v in values {
+                    carry += v.freeze_raw();
+                    *v = <$fast_ty>::new(carry);
+                }
+            }
+
+            pub(crate) unsafe fn [<cummax_slice_ $base_ty>](
+                ptr: *mut $fast_ty,
+                len: usize,
+            ) {
+                let values = core::slice::from_raw_parts_mut(ptr, len);
+                let mut carry = $base_ty::MIN;
+                for v in values {
+                    let raw = v.freeze_raw();
+                    if raw > carry {
+                        carry = raw;
+                    }
+                    *v = <$fast_ty>::new(carry);
+                }
+            }
+
+            pub(crate) unsafe fn [<axpy_ $base_ty>](
+                alpha: $fast_ty,
+                x: *const $fast_ty,
+                y: *mut $fast_ty,
+                n: usize,
+            ) {
+                let alpha = alpha.freeze_raw();
+                let x = core::slice::from_raw_parts(x, n);
+                let y = core::slice::from_raw_parts_mut(y, n);
+                for i in 0..n {
+                    y[i] = <$fast_ty>::new(alpha.mul_add(x[i].freeze_raw(), y[i].freeze_raw()));
+                }
+            }
+
+            pub(crate) unsafe fn [<scale_slice_ $base_ty>](
+                alpha: $fast_ty,
+                x: *mut $fast_ty,
+                n: usize,
+            ) {
+                let alpha = alpha.freeze_raw();
+                let x = core::slice::from_raw_parts_mut(x, n);
+                for v in x {
+                    *v = <$fast_ty>::new(v.freeze_raw() * alpha);
+                }
+            }
+
+            pub(crate) unsafe fn [<gemv_ $base_ty>](
+                a: *const $fast_ty,
+                x: *const $fast_ty,
+                y: *mut $fast_ty,
+                m: usize,
+                n: usize,
+            ) {
+                let a = core::slice::from_raw_parts(a, m * n);
+                let x = core::slice::from_raw_parts(x, n);
+                let y = core::slice::from_raw_parts_mut(y, m);
+                for i in 0..m {
+                    let mut acc = 0.0;
+                    for j in 0..n {
+                        acc = a[i * n + j].freeze_raw().mul_add(x[j].freeze_raw(), acc);
+                    }
+                    y[i] = <$fast_ty>::new(acc);
+                }
+            }
+
+            pub(crate) unsafe fn [<gemm_ $base_ty>](
+                a: *const $fast_ty,
+                b: *const $fast_ty,
+                c: *mut $fast_ty,
+                m: usize,
+                k: usize,
+                n: usize,
+            ) {
+                let a = core::slice::from_raw_parts(a, m * k);
+                let b = core::slice::from_raw_parts(b, k * n);
+                let c = core::slice::from_raw_parts_mut(c, m * n);
+                for i in 0..m {
+                    for j in 0..n {
+                        c[i * n + j] = <$fast_ty>::new(0.0);
+                    }
+                    for l in 0..k {
+                        let ail = a[i * k + l].freeze_raw();
+                        for j in 0..n {
+                            c[i * n + j] = <$fast_ty>::new(
+                                ail.mul_add(b[l * n + j].freeze_raw(), c[i * n + j].freeze_raw()),
+                            );
+                        }
+                    }
+                }
+            }
+        }
+    };
+}
+
+slice_fallback! { FF32, f32 }
+slice_fallback! { FF64, f64 }
+
+macro_rules! slice_transcendental_fallback {
+    ($base_ty:ident: $($fn:ident, $method:ident;)*) => {
+        paste! {
+            $(
+                pub(crate) unsafe fn [<$fn _slice_ $base_ty>](ptr: *mut $base_ty, len: usize) {
+                    let values = core::slice::from_raw_parts_mut(ptr, len);
+                    for v in values {
+                        *v = v.$method();
+                    }
+                }
+            )*
+        }
+    };
+}
+
+slice_transcendental_fallback! { f32: exp, exp; ln, ln; sin, sin; cos, cos; tanh, tanh; }
+slice_transcendental_fallback! { f64: exp, exp; ln, ln; sin, sin; cos, cos; tanh, tanh; }
@@ -1,7 +1,14 @@
-use crate::{FF32, FF64};
-use core::ops::{Add, Div, Mul, Neg, Rem, Sub};
+use crate::{FF32x4, FF32x8, FF64x2, FF64x4, FF32, FF64};
+use core::ops::{Add, AddAssign, Div, DivAssign, Mul, MulAssign, Neg, Rem, Sub, SubAssign};
 use paste::paste;
 
+// with the fallback backend the extern kernel declarations below are replaced by pure-rust
+// functions of the same names and signatures, so the call sites are untouched
+#[cfg(feature = "fallback")]
+pub(crate) mod fallback;
+#[cfg(feature = "fallback")]
+use fallback::*;
+
 macro_rules! impl_binary_refs {
     ($lhs:ident, $rhs:ident, $op_trait:ident, $op_fn:ident) => {
         impl $op_trait<$rhs> for &$lhs {
@@ -39,6 +46,8 @@ macro_rules! impl_fast_ops {
 
                 #[inline(always)]
                 fn $op_fn(self, other: $fast_ty) -> Self::Output {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
                     unsafe { $op_impl(self, other) }
                 }
             }
@@ -73,6 +82,7 @@ macro_rules! poison_safe_fns {
      $(fn $fn:ident(self $(, $arg:ident : Self)*) -> Self;)*) => {
         paste! {
             $(
+                #[cfg(not(feature = "fallback"))]
                 #[link(name = "poison_safe")]
                 extern "C" {
                     // functions in the poison_safe lib can accept poison args.
@@ -86,6 +96,8 @@ macro_rules! poison_safe_fns {
                 $(
                     #[inline]
                     pub fn $fn(self $(, $arg: Self)*) -> Self {
+                        #[cfg(feature = "profiling")]
+                        crate::profiling::count_fast_op();
                         unsafe { [<$fn _ $base_ty>](self $(, $arg)*) }
                     }
                 )*
@@ -99,6 +111,7 @@ macro_rules! poison_unsafe_fns {
      $(fn $fn:ident(self $(, $arg:ident : Self)*) -> Self;)*) => {
         paste! {
             $(
+                #[cfg(not(feature = "fallback"))]
                 #[link(name = "poison_unsafe")]
                 extern "C" {
                     // functions in the poison_unsafe lib must have their arguments frozen, which
@@ -112,6 +125,8 @@ macro_rules! poison_unsafe_fns {
                 $(
                     #[inline]
                     pub fn $fn(self $(, $arg: Self)*) -> Self {
+                        #[cfg(feature = "profiling")]
+                        crate::profiling::count_frozen_op();
                         unsafe { [<$fn _ $base_ty>](self.freeze_raw() $(, $arg.freeze_raw())*) }
                     }
                 )*
@@ -128,6 +143,13 @@ macro_rules! impl_extern_math {
             fn copysign(self, other: Self) -> Self;
             fn max(self, other: Self) -> Self;
             fn min(self, other: Self) -> Self;
+            fn mul_add(self, mul: Self, add: Self) -> Self;
+            // branchless conditionals: `a.select_gt(b, t, f)` is `if a > b { t } else { f }`
+            // compiled as a select, with no freeze and no bool materialization
+            fn select_ge(self, other: Self, if_true: Self, if_false: Self) -> Self;
+            fn select_gt(self, other: Self, if_true: Self, if_false: Self) -> Self;
+            fn select_le(self, other: Self, if_true: Self, if_false: Self) -> Self;
+            fn select_lt(self, other: Self, if_true: Self, if_false: Self) -> Self;
         }
 
         poison_unsafe_fns! {
@@ -162,6 +184,7 @@ macro_rules! impl_extern_math {
         }
 
         paste! {
+            #[cfg(not(feature = "fallback"))]
             #[link(name = "poison_safe")]
             extern "C" {
                 fn [<add_ $base_ty>](a: $fast_ty, b: $fast_ty) -> $fast_ty;
@@ -172,25 +195,170 @@ macro_rules! impl_extern_math {
 
                 fn [<clamp_ $base_ty>](a: $fast_ty, min: $fast_ty, max: $fast_ty) -> $fast_ty;
                 fn [<powi_ $base_ty>](a: $fast_ty, b: i32) -> $fast_ty;
+
+                fn [<poly_eval_ $base_ty>](
+                    coeffs: *const $fast_ty,
+                    n: usize,
+                    x: $fast_ty,
+                ) -> $fast_ty;
+
+                fn [<approx_recip_ $base_ty>](a: $fast_ty) -> $fast_ty;
+                fn [<approx_recip_refined_ $base_ty>](a: $fast_ty) -> $fast_ty;
+                fn [<approx_rsqrt_ $base_ty>](a: $fast_ty) -> $fast_ty;
+                fn [<approx_rsqrt_refined_ $base_ty>](a: $fast_ty) -> $fast_ty;
             }
 
+            #[cfg(not(feature = "fallback"))]
             #[link(name = "poison_unsafe")]
             extern "C" {
                 fn [<rem_ $base_ty>](a: $base_ty, b: $base_ty) -> $fast_ty;
+                fn [<sin_cos_ $base_ty>](
+                    a: $base_ty,
+                    sin_out: *mut $base_ty,
+                    cos_out: *mut $base_ty,
+                );
             }
 
             // a few functions are special cases and aren't defined in submacros
             impl $fast_ty {
                 #[inline]
                 pub fn clamp(self, min: Self, max: Self) -> Self {
+                    // the assertion's freezes are counted at the freeze boundary itself
                     assert!(min <= max);
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    unsafe { [<clamp_ $base_ty>](self, min, max) }
+                }
+
+                /// Like [`clamp`](Self::clamp), but without the `min <= max` assertion.
+                ///
+                /// The assertion compares through the freezing `PartialOrd` path, so the checked
+                /// clamp costs two freezes plus a branch per call even though the kernel itself
+                /// is branchless. When the bounds are loop invariant that cost can dominate;
+                /// this variant is just the select kernel.
+                ///
+                /// This is still a safe function: if `min > max` the result is unspecified, but
+                /// not undefined behavior
+                #[inline]
+                pub fn clamp_unchecked(self, min: Self, max: Self) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
                     unsafe { [<clamp_ $base_ty>](self, min, max) }
                 }
 
                 #[inline]
                 pub fn powi(self, n: i32) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
                     unsafe { [<powi_ $base_ty>](self, n) }
                 }
+
+                /// Evaluate the polynomial with the given coefficients at `self`, by Horner's
+                /// rule with fused multiply-adds.
+                ///
+                /// `coeffs` is ordered highest degree first, so `x.poly_eval(&[a, b, c])`
+                /// computes `a * x² + b * x + c`. The whole recurrence runs inside one
+                /// kernel, rather than one [`mul_add`](Self::mul_add) FFI call per
+                /// coefficient. An empty coefficient slice evaluates to zero
+                #[inline]
+                pub fn poly_eval(self, coeffs: &[Self]) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    unsafe { [<poly_eval_ $base_ty>](coeffs.as_ptr(), coeffs.len(), self) }
+                }
+
+                /// Like [`poly_eval`](Self::poly_eval), with the degree fixed at compile
+                /// time. The coefficient count is a const parameter, so once LTO inlines the
+                /// kernel the Horner loop fully unrolls into a straight FMA chain
+                #[inline(always)]
+                pub fn poly_eval_const<const N: usize>(self, coeffs: &[Self; N]) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    unsafe { [<poly_eval_ $base_ty>](coeffs.as_ptr(), N, self) }
+                }
+
+                /// Like [`powi`](Self::powi), but with the exponent fixed at compile time.
+                ///
+                /// The runtime `powi` is an opaque call with a loop inside unless the
+                /// optimizer happens to constant-fold the exponent. Here the exponent is a
+                /// const parameter, so the square-and-multiply loop below fully unrolls and
+                /// small powers like `x.powi_const::<2>()` are guaranteed to compile down to
+                /// the bare fast multiply kernels
+                #[inline(always)]
+                pub fn powi_const<const N: i32>(self) -> Self {
+                    let mut base = if N < 0 { <$fast_ty>::new(1.0) / self } else { self };
+                    let mut exp = N.unsigned_abs();
+                    let mut acc = <$fast_ty>::new(1.0);
+                    while exp > 0 {
+                        if exp & 1 == 1 {
+                            acc = acc * base;
+                        }
+                        base = base * base;
+                        exp >>= 1;
+                    }
+                    // the leading 1.0 factor folds away under the fast-math flags
+                    acc
+                }
+
+                /// An approximation of `1 / self`, using a hardware reciprocal estimate where
+                /// one is available.
+                ///
+                /// On x86 the `f32` variant compiles to `rcpss`, which is accurate to roughly
+                /// 12 bits; on targets (and for `f64`) without an estimate instruction this
+                /// falls back to the ordinary fast-math division
+                #[inline]
+                pub fn approx_recip(self) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    unsafe { [<approx_recip_ $base_ty>](self) }
+                }
+
+                /// Like [`approx_recip`](Self::approx_recip), refined with one Newton-Raphson
+                /// step for nearly full precision, still well below the cost of a true divide
+                #[inline]
+                pub fn approx_recip_refined(self) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    unsafe { [<approx_recip_refined_ $base_ty>](self) }
+                }
+
+                /// An approximation of `1 / self.sqrt()`, using a hardware reciprocal square
+                /// root estimate where one is available.
+                ///
+                /// On x86 the `f32` variant compiles to `rsqrtss`, which is accurate to
+                /// roughly 12 bits; on targets (and for `f64`) without an estimate
+                /// instruction this falls back to the ordinary fast-math `1 / sqrt`.
+                ///
+                /// This is the building block for fast vector normalization: multiplying by
+                /// the approximate rsqrt of the squared norm avoids both the `sqrt` and the
+                /// divide
+                #[inline]
+                pub fn approx_rsqrt(self) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    unsafe { [<approx_rsqrt_ $base_ty>](self) }
+                }
+
+                /// Like [`approx_rsqrt`](Self::approx_rsqrt), refined with one Newton-Raphson
+                /// step for nearly full precision
+                #[inline]
+                pub fn approx_rsqrt_refined(self) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    unsafe { [<approx_rsqrt_refined_ $base_ty>](self) }
+                }
+
+                /// Simultaneously computes the sine and cosine, sharing one argument reduction
+                #[inline]
+                pub fn sin_cos(self) -> (Self, Self) {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_frozen_op();
+                    let a = self.freeze_raw();
+                    let mut sin = 0.0;
+                    let mut cos = 0.0;
+                    unsafe { [<sin_cos_ $base_ty>](a, &mut sin, &mut cos) }
+                    (<$fast_ty>::new(sin), <$fast_ty>::new(cos))
+                }
             }
 
             impl_fast_ops! {
@@ -206,6 +374,8 @@ macro_rules! impl_extern_math {
 
                 #[inline(always)]
                 fn neg(self) -> Self::Output {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
                     unsafe { [<neg_ $base_ty>](self) }
                 }
             }
@@ -224,6 +394,8 @@ macro_rules! impl_extern_math {
 
                 #[inline(always)]
                 fn rem(self, other: $fast_ty) -> Self::Output {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_frozen_op();
                     unsafe { [<rem_ $base_ty>](self.freeze_raw(), other.freeze_raw()) }
                 }
             }
@@ -233,6 +405,8 @@ macro_rules! impl_extern_math {
 
                 #[inline(always)]
                 fn rem(self, other: $base_ty) -> Self::Output {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_frozen_op();
                     unsafe { [<rem_ $base_ty>](self.freeze_raw(), other) }
                 }
             }
@@ -242,6 +416,8 @@ macro_rules! impl_extern_math {
 
                 #[inline(always)]
                 fn rem(self, other: $fast_ty) -> Self::Output {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_frozen_op();
                     unsafe { [<rem_ $base_ty>](self, other.freeze_raw()) }
                 }
             }
@@ -255,3 +431,199 @@ macro_rules! impl_extern_math {
 
 impl_extern_math! { FF32, f32 }
 impl_extern_math! { FF64, f64 }
+
+macro_rules! impl_wide_binary_op {
+    ($wide_ty:ident, $op_trait:ident, $op_fn:ident, $op_impl:ident) => {
+        impl $op_trait<$wide_ty> for $wide_ty {
+            type Output = $wide_ty;
+
+            #[inline(always)]
+            fn $op_fn(self, other: $wide_ty) -> Self::Output {
+                #[cfg(feature = "profiling")]
+                crate::profiling::count_fast_op();
+                let mut out = core::mem::MaybeUninit::<$wide_ty>::uninit();
+                // the kernel always fully initializes `out`
+                unsafe {
+                    $op_impl(&self, &other, out.as_mut_ptr());
+                    out.assume_init()
+                }
+            }
+        }
+
+        impl_binary_refs! { $wide_ty, $wide_ty, $op_trait, $op_fn }
+    };
+}
+
+macro_rules! impl_wide_assign_ops {
+    ($wide_ty:ident: $($op_trait:ident, $op_fn:ident, $op:ident,)*) => {
+        $(
+            impl $op_trait<$wide_ty> for $wide_ty {
+                #[inline(always)]
+                fn $op_fn(&mut self, rhs: $wide_ty) {
+                    *self = <$wide_ty>::$op(*self, rhs)
+                }
+            }
+
+            impl $op_trait<&$wide_ty> for $wide_ty {
+                #[inline(always)]
+                fn $op_fn(&mut self, rhs: &$wide_ty) {
+                    *self = <$wide_ty>::$op(*self, *rhs)
+                }
+            }
+        )*
+    };
+}
+
+macro_rules! impl_wide_extern_math {
+    ($wide_ty:ident, $suffix:ident) => {
+        paste! {
+            #[cfg(not(feature = "fallback"))]
+            #[link(name = "poison_safe")]
+            extern "C" {
+                // the wide kernels pass their operands through memory instead of by value, so
+                // the FFI does not depend on the ABI classification of vector aggregates. With
+                // always_inline and cross-language LTO the loads and stores collapse back into
+                // vector registers
+                fn [<add_ $suffix>](a: *const $wide_ty, b: *const $wide_ty, out: *mut $wide_ty);
+                fn [<sub_ $suffix>](a: *const $wide_ty, b: *const $wide_ty, out: *mut $wide_ty);
+                fn [<mul_ $suffix>](a: *const $wide_ty, b: *const $wide_ty, out: *mut $wide_ty);
+                fn [<div_ $suffix>](a: *const $wide_ty, b: *const $wide_ty, out: *mut $wide_ty);
+                fn [<neg_ $suffix>](a: *const $wide_ty, out: *mut $wide_ty);
+                fn [<min_ $suffix>](a: *const $wide_ty, b: *const $wide_ty, out: *mut $wide_ty);
+                fn [<max_ $suffix>](a: *const $wide_ty, b: *const $wide_ty, out: *mut $wide_ty);
+                fn [<clamp_ $suffix>](
+                    a: *const $wide_ty,
+                    min: *const $wide_ty,
+                    max: *const $wide_ty,
+                    out: *mut $wide_ty,
+                );
+            }
+
+            impl $wide_ty {
+                /// Lanewise minimum of the two values
+                #[inline]
+                pub fn min(self, other: Self) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    let mut out = core::mem::MaybeUninit::<$wide_ty>::uninit();
+                    unsafe {
+                        [<min_ $suffix>](&self, &other, out.as_mut_ptr());
+                        out.assume_init()
+                    }
+                }
+
+                /// Lanewise maximum of the two values
+                #[inline]
+                pub fn max(self, other: Self) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    let mut out = core::mem::MaybeUninit::<$wide_ty>::uninit();
+                    unsafe {
+                        [<max_ $suffix>](&self, &other, out.as_mut_ptr());
+                        out.assume_init()
+                    }
+                }
+
+                /// Lanewise clamp of the value between `min` and `max`.
+                ///
+                /// Unlike the scalar `clamp`, this does not assert `min <= max` -- a per-lane
+                /// check would freeze every lane on every call. Lanes where `min > max` instead
+                /// produce unspecified values
+                #[inline]
+                pub fn clamp(self, min: Self, max: Self) -> Self {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    let mut out = core::mem::MaybeUninit::<$wide_ty>::uninit();
+                    unsafe {
+                        [<clamp_ $suffix>](&self, &min, &max, out.as_mut_ptr());
+                        out.assume_init()
+                    }
+                }
+            }
+
+            impl_wide_binary_op! { $wide_ty, Add, add, [<add_ $suffix>] }
+            impl_wide_binary_op! { $wide_ty, Sub, sub, [<sub_ $suffix>] }
+            impl_wide_binary_op! { $wide_ty, Mul, mul, [<mul_ $suffix>] }
+            impl_wide_binary_op! { $wide_ty, Div, div, [<div_ $suffix>] }
+
+            impl Neg for $wide_ty {
+                type Output = $wide_ty;
+
+                #[inline(always)]
+                fn neg(self) -> Self::Output {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_fast_op();
+                    let mut out = core::mem::MaybeUninit::<$wide_ty>::uninit();
+                    unsafe {
+                        [<neg_ $suffix>](&self, out.as_mut_ptr());
+                        out.assume_init()
+                    }
+                }
+            }
+
+            impl Neg for &$wide_ty {
+                type Output = <$wide_ty as Neg>::Output;
+
+                #[inline]
+                fn neg(self) -> Self::Output {
+                    -(*self)
+                }
+            }
+
+            impl_wide_assign_ops! {
+                $wide_ty:
+                AddAssign, add_assign, add,
+                SubAssign, sub_assign, sub,
+                MulAssign, mul_assign, mul,
+                DivAssign, div_assign, div,
+            }
+        }
+    };
+}
+
+impl_wide_extern_math! { FF32x4, f32x4 }
+impl_wide_extern_math! { FF32x8, f32x8 }
+impl_wide_extern_math! { FF64x2, f64x2 }
+impl_wide_extern_math! { FF64x4, f64x4 }
+
+#[cfg(test)]
+mod tests {
+    use crate::{ff32, ff64};
+
+    // powi_const is the one pure-rust exponentiation path (the runtime powi is a kernel);
+    // its square-and-multiply loop and negative-exponent handling are testable without the
+    // C kernels, so they run under --features fallback too. Results are read back through
+    // the freezing From conversions
+
+    #[test]
+    fn powi_const_small_powers() {
+        assert_eq!(f32::from(ff32(3.0).powi_const::<2>()), 9.0);
+        assert_eq!(f32::from(ff32(2.0).powi_const::<10>()), 1024.0);
+        assert_eq!(f32::from(ff32(5.0).powi_const::<1>()), 5.0);
+        assert_eq!(f64::from(ff64(2.0).powi_const::<31>()), 2147483648.0);
+    }
+
+    #[test]
+    fn powi_const_zero_exponent() {
+        assert_eq!(f32::from(ff32(123.25).powi_const::<0>()), 1.0);
+        assert_eq!(f64::from(ff64(0.5).powi_const::<0>()), 1.0);
+    }
+
+    #[test]
+    fn powi_const_negative_exponents() {
+        assert_eq!(f32::from(ff32(2.0).powi_const::<-2>()), 0.25);
+        assert_eq!(f32::from(ff32(2.0).powi_const::<-3>()), 0.125);
+        assert_eq!(f64::from(ff64(4.0).powi_const::<-1>()), 0.25);
+    }
+
+    #[test]
+    fn powi_const_min_exponent() {
+        // -N overflows i32 at i32::MIN; unsigned_abs keeps the loop well defined there.
+        // A base of 1 is exact at any exponent, and any base > 1 underflows the 2^31
+        // reciprocal power to a hard zero
+        assert_eq!(f32::from(ff32(1.0).powi_const::<{ i32::MIN }>()), 1.0);
+        assert_eq!(f32::from(ff32(2.0).powi_const::<{ i32::MIN }>()), 0.0);
+        assert_eq!(f64::from(ff64(1.0).powi_const::<{ i32::MIN }>()), 1.0);
+        assert_eq!(f64::from(ff64(2.0).powi_const::<{ i32::MIN }>()), 0.0);
+    }
+}
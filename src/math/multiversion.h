@@ -0,0 +1,83 @@
+/*
+ * Runtime-dispatched multiversioning for the bulk kernels.
+ *
+ * The bulk kernels benefit most from wide vectors, but a distributed binary
+ * is typically compiled for a baseline ISA. __attribute__((target_clones))
+ * would express per-ISA clones directly, but clang only supports it from
+ * version 14, and this crate is pinned to clang 13 to match rustc's LLVM (see
+ * the README's toolchain notes). The clones and their resolver are therefore
+ * spelled out by hand: the kernel body is written once as an always_inline
+ * NAME_impl function, and FF_DEFINE_DISPATCH instantiates it per ISA through
+ * target attributes, binding the public symbol to an ifunc whose resolver
+ * picks a clone when the loader first binds the call. Restricted to x86-64
+ * ELF targets, where ifunc support is available; elsewhere the public symbol
+ * is a plain wrapper around the baseline body.
+ *
+ * The per-element kernels are not multiversioned: they rely on always_inline
+ * + LTO, which the ifunc indirection would defeat.
+ */
+
+#ifndef FF_MULTIVERSION_H
+#define FF_MULTIVERSION_H
+
+#define FF_MV_BODY static inline __attribute__((always_inline))
+
+#if defined(__x86_64__) && defined(__ELF__)
+
+#define FF_DEFINE_DISPATCH(RET, NAME, PARAMS, ARGS)                            \
+  __attribute__((target("avx512f")))                                           \
+  static RET NAME ## _avx512f PARAMS { return NAME ## _impl ARGS; }            \
+                                                                               \
+  __attribute__((target("avx2")))                                              \
+  static RET NAME ## _avx2 PARAMS { return NAME ## _impl ARGS; }               \
+                                                                               \
+  static RET NAME ## _default PARAMS { return NAME ## _impl ARGS; }            \
+                                                                               \
+  static RET (*NAME ## _resolver(void)) PARAMS {                               \
+    __builtin_cpu_init();                                                      \
+    if (__builtin_cpu_supports("avx512f")) {                                   \
+      return NAME ## _avx512f;                                                 \
+    }                                                                          \
+    if (__builtin_cpu_supports("avx2")) {                                      \
+      return NAME ## _avx2;                                                    \
+    }                                                                          \
+    return NAME ## _default;                                                   \
+  }                                                                            \
+                                                                               \
+  RET NAME PARAMS __attribute__((ifunc(#NAME "_resolver")))
+
+/* same dispatch for kernels returning void, where the wrappers cannot
+ * `return` the call without tripping pedantic diagnostics */
+#define FF_DEFINE_DISPATCH_VOID(NAME, PARAMS, ARGS)                            \
+  __attribute__((target("avx512f")))                                           \
+  static void NAME ## _avx512f PARAMS { NAME ## _impl ARGS; }                  \
+                                                                               \
+  __attribute__((target("avx2")))                                              \
+  static void NAME ## _avx2 PARAMS { NAME ## _impl ARGS; }                     \
+                                                                               \
+  static void NAME ## _default PARAMS { NAME ## _impl ARGS; }                  \
+                                                                               \
+  static void (*NAME ## _resolver(void)) PARAMS {                              \
+    __builtin_cpu_init();                                                      \
+    if (__builtin_cpu_supports("avx512f")) {                                   \
+      return NAME ## _avx512f;                                                 \
+    }                                                                          \
+    if (__builtin_cpu_supports("avx2")) {                                      \
+      return NAME ## _avx2;                                                    \
+    }                                                                          \
+    return NAME ## _default;                                                   \
+  }                                                                            \
+                                                                               \
+  void NAME PARAMS __attribute__((ifunc(#NAME "_resolver")))
+
+#else
+
+#define FF_DEFINE_DISPATCH(RET, NAME, PARAMS, ARGS)                            \
+  RET NAME PARAMS { return NAME ## _impl ARGS; }
+
+#define FF_DEFINE_DISPATCH_VOID(NAME, PARAMS, ARGS)                            \
+  void NAME PARAMS { NAME ## _impl ARGS; }
+
+#endif
+
+#endif
@@ -62,6 +62,54 @@ IMPL_BINARY_FUNCTION(double, f64, max, fmax)
 IMPL_BINARY_FUNCTION(float, f32, min, fminf)
 IMPL_BINARY_FUNCTION(double, f64, min, fmin)
 
+// a dedicated fma kernel rather than mul-then-add, so fusion doesn't depend
+// on -ffp-contract seeing both halves after LTO inlining
+__attribute__((always_inline))
+float mul_add_f32(float a, float b, float c) {
+  return __builtin_fmaf(a, b, c);
+}
+
+__attribute__((always_inline))
+double mul_add_f64(double a, double b, double c) {
+  return __builtin_fma(a, b, c);
+}
+
+/*
+ * Horner polynomial evaluation with real FMA. Keeping the whole recurrence in
+ * one kernel means a degree-n evaluation is one FFI boundary instead of n
+ * mul_add calls; coefficients are ordered highest degree first. The slice
+ * variant evaluates one polynomial across many inputs, where the independent
+ * per-input recurrences vectorize, and so is worth multiversioned clones
+ * (the dispatch machinery is included below, before its other users).
+ */
+#define IMPL_POLY_EVAL(C_TYPE, RUST_TYPE, FMA_FN)                              \
+  __attribute__((always_inline))                                               \
+  C_TYPE poly_eval_ ## RUST_TYPE(const C_TYPE *coeffs, size_t n, C_TYPE x) {   \
+    C_TYPE acc = n > 0 ? coeffs[0] : 0;                                        \
+    for (size_t i = 1; i < n; i++) {                                           \
+      acc = FMA_FN(acc, x, coeffs[i]);                                         \
+    }                                                                          \
+    return acc;                                                                \
+  }                                                                            \
+                                                                               \
+  FF_MV_BODY                                                                   \
+  void poly_eval_slice_ ## RUST_TYPE ## _impl(const C_TYPE *coeffs, size_t n,  \
+                                              const C_TYPE *xs, C_TYPE *out,  \
+                                              size_t len) {                    \
+    for (size_t i = 0; i < len; i++) {                                         \
+      C_TYPE acc = n > 0 ? coeffs[0] : 0;                                      \
+      for (size_t j = 1; j < n; j++) {                                         \
+        acc = FMA_FN(acc, xs[i], coeffs[j]);                                   \
+      }                                                                        \
+      out[i] = acc;                                                            \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH_VOID(poly_eval_slice_ ## RUST_TYPE,                       \
+                          (const C_TYPE *coeffs, size_t n, const C_TYPE *xs,   \
+                           C_TYPE *out, size_t len),                           \
+                          (coeffs, n, xs, out, len));                          \
+
 __attribute__((always_inline))
 float powi_f32(float a, int b) {
   return __builtin_powif(a, b);
@@ -96,3 +144,457 @@ double clamp_f64(double a, double min, double max) {
   return a;
 }
 
+/*
+ * Hardware approximate reciprocal and reciprocal square root. The f32
+ * variants lower to rcpss/rsqrtss on x86, which give roughly 12 bits of
+ * precision; one Newton-Raphson step in the *_refined variants brings that to
+ * nearly full single precision at a fraction of the cost of a true divide or
+ * sqrt. Targets without the instructions (and f64, which has no legacy SSE
+ * approximation) fall back to the plain division/sqrt, which the fast-math
+ * flags on this file are free to relax.
+ */
+#if defined(__SSE__)
+#include <immintrin.h>
+
+__attribute__((always_inline))
+float approx_recip_f32(float a) {
+  return _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(a)));
+}
+
+__attribute__((always_inline))
+float approx_rsqrt_f32(float a) {
+  return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a)));
+}
+#else
+__attribute__((always_inline))
+float approx_recip_f32(float a) {
+  return 1.0f / a;
+}
+
+__attribute__((always_inline))
+float approx_rsqrt_f32(float a) {
+  return 1.0f / __builtin_sqrtf(a);
+}
+#endif
+
+__attribute__((always_inline))
+double approx_recip_f64(double a) {
+  return 1.0 / a;
+}
+
+__attribute__((always_inline))
+double approx_rsqrt_f64(double a) {
+  return 1.0 / __builtin_sqrt(a);
+}
+
+// one Newton-Raphson step on the approximations above; a no-op refinement
+// when the base is already exact (as in the fallbacks)
+__attribute__((always_inline))
+float approx_recip_refined_f32(float a) {
+  float r = approx_recip_f32(a);
+  return r * (2.0f - a * r);
+}
+
+__attribute__((always_inline))
+double approx_recip_refined_f64(double a) {
+  double r = approx_recip_f64(a);
+  return r * (2.0 - a * r);
+}
+
+__attribute__((always_inline))
+float approx_rsqrt_refined_f32(float a) {
+  float r = approx_rsqrt_f32(a);
+  return r * (1.5f - 0.5f * a * r * r);
+}
+
+__attribute__((always_inline))
+double approx_rsqrt_refined_f64(double a) {
+  double r = approx_rsqrt_f64(a);
+  return r * (1.5 - 0.5 * a * r * r);
+}
+
+/*
+ * Branchless compare-and-select kernels. As with clamp above, under -O3 the
+ * comparisons are compiled to selects which, unlike branches, propagate
+ * poison without UB. These let conditional logic in hot loops stay free of
+ * the freezing comparison operators and remain vectorizable.
+ */
+#define IMPL_SELECT(C_TYPE, RUST_TYPE, NAME, CMP)                   \
+  __attribute__((always_inline))                                    \
+  C_TYPE NAME ## _ ## RUST_TYPE(C_TYPE a, C_TYPE b,                 \
+                                C_TYPE if_true, C_TYPE if_false) {  \
+    return a CMP b ? if_true : if_false;                            \
+  }                                                                 \
+
+IMPL_SELECT(float, f32, select_ge, >=)
+IMPL_SELECT(double, f64, select_ge, >=)
+
+IMPL_SELECT(float, f32, select_gt, >)
+IMPL_SELECT(double, f64, select_gt, >)
+
+IMPL_SELECT(float, f32, select_le, <=)
+IMPL_SELECT(double, f64, select_le, <=)
+
+IMPL_SELECT(float, f32, select_lt, <)
+IMPL_SELECT(double, f64, select_lt, <)
+
+/*
+ * Wide lane-parallel kernels backing the FF32x4/FF32x8/FF64x2/FF64x4 types.
+ *
+ * Operands are passed through memory instead of by value so that the FFI does
+ * not depend on the ABI classification of vector aggregates; with
+ * always_inline and cross-language LTO the loads and stores collapse back
+ * into vector registers. The memcpys compile to single (unaligned) vector
+ * loads and stores, since the rust types are only element-aligned.
+ *
+ * min/max/clamp use the same select-compiled comparisons as the scalar clamp
+ * above, which propagate poison without UB.
+ */
+
+#define IMPL_WIDE_OPERATIONS(C_TYPE, RUST_TYPE, LANES)                         \
+  typedef C_TYPE vec_ ## RUST_TYPE                                             \
+      __attribute__((vector_size(sizeof(C_TYPE) * LANES)));                    \
+                                                                               \
+  __attribute__((always_inline))                                               \
+  void add_ ## RUST_TYPE(const C_TYPE *a, const C_TYPE *b, C_TYPE *out) {      \
+    vec_ ## RUST_TYPE va, vb;                                                  \
+    __builtin_memcpy(&va, a, sizeof va);                                       \
+    __builtin_memcpy(&vb, b, sizeof vb);                                       \
+    va = va + vb;                                                              \
+    __builtin_memcpy(out, &va, sizeof va);                                     \
+  }                                                                            \
+                                                                               \
+  __attribute__((always_inline))                                               \
+  void sub_ ## RUST_TYPE(const C_TYPE *a, const C_TYPE *b, C_TYPE *out) {      \
+    vec_ ## RUST_TYPE va, vb;                                                  \
+    __builtin_memcpy(&va, a, sizeof va);                                       \
+    __builtin_memcpy(&vb, b, sizeof vb);                                       \
+    va = va - vb;                                                              \
+    __builtin_memcpy(out, &va, sizeof va);                                     \
+  }                                                                            \
+                                                                               \
+  __attribute__((always_inline))                                               \
+  void mul_ ## RUST_TYPE(const C_TYPE *a, const C_TYPE *b, C_TYPE *out) {      \
+    vec_ ## RUST_TYPE va, vb;                                                  \
+    __builtin_memcpy(&va, a, sizeof va);                                       \
+    __builtin_memcpy(&vb, b, sizeof vb);                                       \
+    va = va * vb;                                                              \
+    __builtin_memcpy(out, &va, sizeof va);                                     \
+  }                                                                            \
+                                                                               \
+  __attribute__((always_inline))                                               \
+  void div_ ## RUST_TYPE(const C_TYPE *a, const C_TYPE *b, C_TYPE *out) {      \
+    vec_ ## RUST_TYPE va, vb;                                                  \
+    __builtin_memcpy(&va, a, sizeof va);                                       \
+    __builtin_memcpy(&vb, b, sizeof vb);                                       \
+    va = va / vb;                                                              \
+    __builtin_memcpy(out, &va, sizeof va);                                     \
+  }                                                                            \
+                                                                               \
+  __attribute__((always_inline))                                               \
+  void neg_ ## RUST_TYPE(const C_TYPE *a, C_TYPE *out) {                       \
+    vec_ ## RUST_TYPE va;                                                      \
+    __builtin_memcpy(&va, a, sizeof va);                                       \
+    va = -va;                                                                  \
+    __builtin_memcpy(out, &va, sizeof va);                                     \
+  }                                                                            \
+                                                                               \
+  __attribute__((always_inline))                                               \
+  void min_ ## RUST_TYPE(const C_TYPE *a, const C_TYPE *b, C_TYPE *out) {      \
+    for (int i = 0; i < LANES; i++) {                                          \
+      out[i] = b[i] < a[i] ? b[i] : a[i];                                      \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  __attribute__((always_inline))                                               \
+  void max_ ## RUST_TYPE(const C_TYPE *a, const C_TYPE *b, C_TYPE *out) {      \
+    for (int i = 0; i < LANES; i++) {                                          \
+      out[i] = b[i] > a[i] ? b[i] : a[i];                                      \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  __attribute__((always_inline))                                               \
+  void clamp_ ## RUST_TYPE(const C_TYPE *a, const C_TYPE *min,                 \
+                           const C_TYPE *max, C_TYPE *out) {                   \
+    for (int i = 0; i < LANES; i++) {                                          \
+      C_TYPE v = a[i];                                                         \
+      v = v < min[i] ? min[i] : v;                                             \
+      v = v > max[i] ? max[i] : v;                                             \
+      out[i] = v;                                                              \
+    }                                                                          \
+  }                                                                            \
+
+IMPL_WIDE_OPERATIONS(float, f32x4, 4)
+IMPL_WIDE_OPERATIONS(float, f32x8, 8)
+IMPL_WIDE_OPERATIONS(double, f64x2, 2)
+IMPL_WIDE_OPERATIONS(double, f64x4, 4)
+
+/*
+ * Whole-slice reduction kernels. Keeping the entire reduction inside one
+ * fast-math compiled function lets the vectorizer reassociate it into
+ * multi-lane partial accumulators, instead of the serial dependency chain a
+ * rust-side fold produces.
+ *
+ * min/max assume n >= 1 (enforced by the rust callers) and use the same
+ * select-compiled comparisons as clamp above, which propagate poison without
+ * UB.
+ */
+
+#include <stddef.h>
+
+/*
+ * The bulk kernels below are multiversioned: per-ISA clones selected once at
+ * load time through an ifunc resolver, so a single artifact gets the
+ * AVX2/AVX-512 paths on capable hosts. See multiversion.h for the dispatch
+ * machinery, and for why it is spelled out by hand rather than with
+ * target_clones.
+ */
+#include "multiversion.h"
+
+#define IMPL_SLICE_REDUCTIONS(C_TYPE, RUST_TYPE)                               \
+  FF_MV_BODY                                                                   \
+  C_TYPE sum_slice_ ## RUST_TYPE ## _impl(const C_TYPE *p, size_t n) {         \
+    C_TYPE acc = 0;                                                            \
+    for (size_t i = 0; i < n; i++) {                                           \
+      acc += p[i];                                                             \
+    }                                                                          \
+    return acc;                                                                \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH(C_TYPE, sum_slice_ ## RUST_TYPE,                          \
+                     (const C_TYPE *p, size_t n), (p, n));                     \
+                                                                               \
+  FF_MV_BODY                                                                   \
+  C_TYPE product_slice_ ## RUST_TYPE ## _impl(const C_TYPE *p, size_t n) {     \
+    C_TYPE acc = 1;                                                            \
+    for (size_t i = 0; i < n; i++) {                                           \
+      acc *= p[i];                                                             \
+    }                                                                          \
+    return acc;                                                                \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH(C_TYPE, product_slice_ ## RUST_TYPE,                      \
+                     (const C_TYPE *p, size_t n), (p, n));                     \
+                                                                               \
+  FF_MV_BODY                                                                   \
+  C_TYPE dot_slice_ ## RUST_TYPE ## _impl(const C_TYPE *a, const C_TYPE *b,    \
+                                          size_t n) {                          \
+    C_TYPE acc = 0;                                                            \
+    for (size_t i = 0; i < n; i++) {                                           \
+      acc += a[i] * b[i];                                                      \
+    }                                                                          \
+    return acc;                                                                \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH(C_TYPE, dot_slice_ ## RUST_TYPE,                          \
+                     (const C_TYPE *a, const C_TYPE *b, size_t n),             \
+                     (a, b, n));                                               \
+                                                                               \
+  FF_MV_BODY                                                                   \
+  C_TYPE min_slice_ ## RUST_TYPE ## _impl(const C_TYPE *p, size_t n) {         \
+    C_TYPE acc = p[0];                                                         \
+    for (size_t i = 1; i < n; i++) {                                           \
+      acc = p[i] < acc ? p[i] : acc;                                           \
+    }                                                                          \
+    return acc;                                                                \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH(C_TYPE, min_slice_ ## RUST_TYPE,                          \
+                     (const C_TYPE *p, size_t n), (p, n));                     \
+                                                                               \
+  FF_MV_BODY                                                                   \
+  C_TYPE max_slice_ ## RUST_TYPE ## _impl(const C_TYPE *p, size_t n) {         \
+    C_TYPE acc = p[0];                                                         \
+    for (size_t i = 1; i < n; i++) {                                           \
+      acc = p[i] > acc ? p[i] : acc;                                           \
+    }                                                                          \
+    return acc;                                                                \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH(C_TYPE, max_slice_ ## RUST_TYPE,                          \
+                     (const C_TYPE *p, size_t n), (p, n));                     \
+
+IMPL_SLICE_REDUCTIONS(float, f32)
+IMPL_SLICE_REDUCTIONS(double, f64)
+
+// expanded here rather than at the definition site so that size_t and the
+// dispatch macros are in scope
+IMPL_POLY_EVAL(float, f32, __builtin_fmaf)
+IMPL_POLY_EVAL(double, f64, __builtin_fma)
+
+/*
+ * BLAS-style level-1/2/3 micro-kernels. Matrices are row-major and dense. The
+ * fast-math flags let the vectorizer reassociate the accumulations into
+ * register-blocked vector FMAs; the gemm loop order (i, l, j) keeps the inner
+ * loop a contiguous fused multiply-add over one row of B and C, which is the
+ * form the vectorizer tiles best.
+ */
+#define IMPL_LINALG(C_TYPE, RUST_TYPE, FMA_FN)                                 \
+  FF_MV_BODY                                                                   \
+  void axpy_ ## RUST_TYPE ## _impl(C_TYPE alpha, const C_TYPE *x, C_TYPE *y,   \
+                                   size_t n) {                                 \
+    for (size_t i = 0; i < n; i++) {                                           \
+      y[i] = FMA_FN(alpha, x[i], y[i]);                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH_VOID(axpy_ ## RUST_TYPE,                                  \
+                          (C_TYPE alpha, const C_TYPE *x, C_TYPE *y,           \
+                           size_t n),                                          \
+                          (alpha, x, y, n));                                   \
+                                                                               \
+  FF_MV_BODY                                                                   \
+  void scale_slice_ ## RUST_TYPE ## _impl(C_TYPE alpha, C_TYPE *x,             \
+                                          size_t n) {                          \
+    for (size_t i = 0; i < n; i++) {                                           \
+      x[i] *= alpha;                                                           \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH_VOID(scale_slice_ ## RUST_TYPE,                           \
+                          (C_TYPE alpha, C_TYPE *x, size_t n),                 \
+                          (alpha, x, n));                                      \
+                                                                               \
+  FF_MV_BODY                                                                   \
+  void gemv_ ## RUST_TYPE ## _impl(const C_TYPE *a, const C_TYPE *x,           \
+                                   C_TYPE *y, size_t m, size_t n) {            \
+    for (size_t i = 0; i < m; i++) {                                           \
+      C_TYPE acc = 0;                                                          \
+      for (size_t j = 0; j < n; j++) {                                         \
+        acc = FMA_FN(a[i * n + j], x[j], acc);                                 \
+      }                                                                        \
+      y[i] = acc;                                                              \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH_VOID(gemv_ ## RUST_TYPE,                                  \
+                          (const C_TYPE *a, const C_TYPE *x, C_TYPE *y,        \
+                           size_t m, size_t n),                                \
+                          (a, x, y, m, n));                                    \
+                                                                               \
+  FF_MV_BODY                                                                   \
+  void gemm_ ## RUST_TYPE ## _impl(const C_TYPE *a, const C_TYPE *b,           \
+                                   C_TYPE *c, size_t m, size_t k,              \
+                                   size_t n) {                                 \
+    for (size_t i = 0; i < m; i++) {                                           \
+      for (size_t j = 0; j < n; j++) {                                         \
+        c[i * n + j] = 0;                                                      \
+      }                                                                        \
+      for (size_t l = 0; l < k; l++) {                                         \
+        C_TYPE ail = a[i * k + l];                                             \
+        for (size_t j = 0; j < n; j++) {                                       \
+          c[i * n + j] = FMA_FN(ail, b[l * n + j], c[i * n + j]);              \
+        }                                                                      \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH_VOID(gemm_ ## RUST_TYPE,                                  \
+                          (const C_TYPE *a, const C_TYPE *b, C_TYPE *c,        \
+                           size_t m, size_t k, size_t n),                      \
+                          (a, b, c, m, k, n));                                 \
+
+IMPL_LINALG(float, f32, __builtin_fmaf)
+IMPL_LINALG(double, f64, __builtin_fma)
+
+/*
+ * Bulk widening decode for the half-precision storage types. Everything is
+ * integer shifts plus one exact float multiply per element, so the loops
+ * vectorize without any hardware half-float support (and pick up F16C-class
+ * instruction selection through the multiversioned clones where available).
+ */
+
+#include <stdint.h>
+
+FF_MV_BODY
+void decode_slice_f16_impl(const uint16_t *src, float *dst, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    union { uint32_t u; float f; } o;
+    /* shifting the half's exponent and mantissa into f32 position leaves the
+     * exponent biased 112 too low; multiplying by 2^112 fixes it with an
+     * exact float op and also normalizes subnormal halves */
+    o.u = ((uint32_t)(src[i] & 0x7fff)) << 13;
+    o.f *= 0x1.0p112f;
+    o.u |= ((uint32_t)(src[i] & 0x8000)) << 16;
+    dst[i] = o.f;
+  }
+}
+
+FF_DEFINE_DISPATCH_VOID(decode_slice_f16,
+                        (const uint16_t *src, float *dst, size_t n),
+                        (src, dst, n));
+
+FF_MV_BODY
+void decode_slice_bf16_impl(const uint16_t *src, float *dst, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    union { uint32_t u; float f; } o;
+    /* bfloat16 is just the top half of an f32 */
+    o.u = (uint32_t)src[i] << 16;
+    dst[i] = o.f;
+  }
+}
+
+FF_DEFINE_DISPATCH_VOID(decode_slice_bf16,
+                        (const uint16_t *src, float *dst, size_t n),
+                        (src, dst, n));
+
+/*
+ * Cumulative (inclusive-scan) kernels. A naive scan is one long loop-carried
+ * dependence, one combine per element. Reassociation (legal under the
+ * fast-math flags, and for max unconditionally) allows restructuring into
+ * blocks of 8 combined at log depth, which shrinks the carried dependence to
+ * one combine per block and leaves the block-local steps free to schedule in
+ * parallel or as vector shuffles. The seed comes from the first element, so
+ * no identity value is needed and the same shape serves both sum and max.
+ */
+#define IMPL_SCAN(C_TYPE, RUST_TYPE, NAME, COMBINE)                            \
+  FF_MV_BODY                                                                   \
+  void NAME ## _slice_ ## RUST_TYPE ## _impl(C_TYPE *p, size_t n) {            \
+    if (n == 0) {                                                              \
+      return;                                                                  \
+    }                                                                          \
+    C_TYPE carry = p[0];                                                       \
+    size_t i = 1;                                                              \
+    for (; i + 8 <= n; i += 8) {                                               \
+      C_TYPE b0 = p[i], b1 = p[i + 1], b2 = p[i + 2], b3 = p[i + 3];           \
+      C_TYPE b4 = p[i + 4], b5 = p[i + 5], b6 = p[i + 6], b7 = p[i + 7];       \
+      /* offset-1 step */                                                      \
+      C_TYPE t1 = COMBINE(b1, b0), t2 = COMBINE(b2, b1);                       \
+      C_TYPE t3 = COMBINE(b3, b2), t4 = COMBINE(b4, b3);                       \
+      C_TYPE t5 = COMBINE(b5, b4), t6 = COMBINE(b6, b5);                       \
+      C_TYPE t7 = COMBINE(b7, b6);                                             \
+      /* offset-2 step */                                                      \
+      C_TYPE u2 = COMBINE(t2, b0), u3 = COMBINE(t3, t1);                       \
+      C_TYPE u4 = COMBINE(t4, t2), u5 = COMBINE(t5, t3);                       \
+      C_TYPE u6 = COMBINE(t6, t4), u7 = COMBINE(t7, t5);                       \
+      /* offset-4 step completes the block-local scan */                       \
+      C_TYPE s4 = COMBINE(u4, b0), s5 = COMBINE(u5, t1);                       \
+      C_TYPE s6 = COMBINE(u6, u2), s7 = COMBINE(u7, u3);                       \
+      p[i] = COMBINE(b0, carry);                                               \
+      p[i + 1] = COMBINE(t1, carry);                                           \
+      p[i + 2] = COMBINE(u2, carry);                                           \
+      p[i + 3] = COMBINE(u3, carry);                                           \
+      p[i + 4] = COMBINE(s4, carry);                                           \
+      p[i + 5] = COMBINE(s5, carry);                                           \
+      p[i + 6] = COMBINE(s6, carry);                                           \
+      p[i + 7] = COMBINE(s7, carry);                                           \
+      carry = p[i + 7];                                                        \
+    }                                                                          \
+    for (; i < n; i++) {                                                       \
+      carry = COMBINE(p[i], carry);                                            \
+      p[i] = carry;                                                            \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  FF_DEFINE_DISPATCH_VOID(NAME ## _slice_ ## RUST_TYPE,                        \
+                          (C_TYPE *p, size_t n), (p, n));
+
+#define FF_SCAN_ADD(a, b) ((a) + (b))
+#define FF_SCAN_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+IMPL_SCAN(float, f32, prefix_sum, FF_SCAN_ADD)
+IMPL_SCAN(double, f64, prefix_sum, FF_SCAN_ADD)
+
+IMPL_SCAN(float, f32, cummax, FF_SCAN_MAX)
+IMPL_SCAN(double, f64, cummax, FF_SCAN_MAX)
+
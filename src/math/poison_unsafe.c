@@ -72,9 +72,52 @@ IMPL_UNARY_FUNCTION(float, f32, ln_1p, log1pf)
 IMPL_UNARY(log2)
 IMPL_UNARY(log10)
 
+/*
+ * In-place slice variants of the hottest transcendentals. The rust callers
+ * freeze the whole buffer in one vectorized pass before calling, so these
+ * kernels only ever see concrete values; a single FFI call then covers the
+ * buffer instead of one freeze + call per element. The libm calls themselves
+ * stay scalar -- without a vector math library (-fveclib, which the build
+ * does not configure) the vectorizer cannot batch them -- so the win here is
+ * amortizing the freeze and FFI overhead, not vectorizing the evaluation.
+ */
+
+#include <stddef.h>
+
+#define IMPL_SLICE_FUNCTION(C_TYPE, RUST_TYPE, FN_NAME, FN_IMPL)   \
+  void FN_NAME ## _slice_ ## RUST_TYPE(C_TYPE *p, size_t n) {      \
+    for (size_t i = 0; i < n; i++) {                               \
+      p[i] = FN_IMPL(p[i]);                                        \
+    }                                                              \
+  }                                                                \
+
+#define IMPL_SLICE(DOUBLE_FN)                                 \
+  IMPL_SLICE_FUNCTION(double, f64, DOUBLE_FN, DOUBLE_FN)      \
+  IMPL_SLICE_FUNCTION(float, f32, DOUBLE_FN, DOUBLE_FN ## f)  \
+
+IMPL_SLICE(exp)
+IMPL_SLICE(sin)
+IMPL_SLICE(cos)
+IMPL_SLICE(tanh)
+
+IMPL_SLICE_FUNCTION(double, f64, ln, log)
+IMPL_SLICE_FUNCTION(float, f32, ln, logf)
+
 IMPL_BINARY_FUNCTION(double, f64, powf, pow)
 IMPL_BINARY_FUNCTION(float, f32, powf, powf)
 
+// computes both results from one argument reduction; the builtin lowers to
+// the libc sincos without needing _GNU_SOURCE for a declaration
+__attribute__((always_inline))
+void sin_cos_f32(float a, float *sin_out, float *cos_out) {
+  __builtin_sincosf(a, sin_out, cos_out);
+}
+
+__attribute__((always_inline))
+void sin_cos_f64(double a, double *sin_out, double *cos_out) {
+  __builtin_sincos(a, sin_out, cos_out);
+}
+
 IMPL_UNARY(round)
 IMPL_UNARY(sin)
 IMPL_UNARY(sinh)
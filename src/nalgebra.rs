@@ -393,7 +393,7 @@ mod nalgebra_v021 {
 
 #[cfg(feature = "nalgebra-v029")]
 #[cfg_attr(docsrs, doc(cfg(feature = "nalgebra-v029")))]
-mod nalgebra_v029 {
+pub(crate) mod nalgebra_v029 {
     macro_rules! real_field {
         ($fast_ty:ident, $base_ty:ident) => {
             #[inline]
@@ -418,4 +418,145 @@ mod nalgebra_v029 {
         ::nalgebra_v029, ::simba_v06, ::approx_v05 ;
         @RealField: real_field
     }
+
+    // The wide types get real multi-lane `SimdValue` impls, so nalgebra can be instantiated
+    // with a batch of lanes per scalar (e.g. `Point3<FF32x8>` runs 8 independent points per
+    // coordinate through the lane-parallel kernels). Only the component-wise arithmetic
+    // surface is covered: `SimdRealField` would require per-lane mask types and wide
+    // transcendental kernels, which the crate doesn't have.
+    macro_rules! simd_value_wide {
+        ($($wide_ty:ident, $fast_ty:ident;)*) => {
+            $(
+                impl simba::simd::PrimitiveSimdValue for $crate::$wide_ty {}
+
+                impl simba::simd::SimdValue for $crate::$wide_ty {
+                    type Element = $crate::$fast_ty;
+                    type SimdBool = bool;
+
+                    #[inline]
+                    fn lanes() -> usize {
+                        <$crate::$wide_ty>::LANES
+                    }
+
+                    #[inline]
+                    fn splat(val: Self::Element) -> Self {
+                        Self::from_lanes([val; <$crate::$wide_ty>::LANES])
+                    }
+
+                    #[inline]
+                    fn extract(&self, i: usize) -> Self::Element {
+                        self.to_lanes()[i]
+                    }
+
+                    #[inline]
+                    unsafe fn extract_unchecked(&self, i: usize) -> Self::Element {
+                        *self.to_lanes().get_unchecked(i)
+                    }
+
+                    #[inline]
+                    fn replace(&mut self, i: usize, val: Self::Element) {
+                        let mut lanes = self.to_lanes();
+                        lanes[i] = val;
+                        *self = Self::from_lanes(lanes);
+                    }
+
+                    #[inline]
+                    unsafe fn replace_unchecked(&mut self, i: usize, val: Self::Element) {
+                        let mut lanes = self.to_lanes();
+                        *lanes.get_unchecked_mut(i) = val;
+                        *self = Self::from_lanes(lanes);
+                    }
+
+                    // the condition is a plain bool, so selection is uniform across the lanes;
+                    // per-lane blends would need a dedicated mask type
+                    #[inline]
+                    fn select(self, cond: Self::SimdBool, other: Self) -> Self {
+                        if cond {
+                            self
+                        } else {
+                            other
+                        }
+                    }
+                }
+            )*
+        };
+    }
+
+    simd_value_wide! {
+        FF32x4, FF32;
+        FF32x8, FF32;
+        FF64x2, FF64;
+        FF64x4, FF64;
+    }
+
+    use crate::slice::{self, SliceOps};
+
+    /// Vectorized whole-matrix sum for matrices of the fast types.
+    ///
+    /// `Matrix::sum` iterates the generic `RealField` impl element by element -- a serial
+    /// dependence chain and, without the LTO setup, an FFI call per element. This extension
+    /// method grabs the contiguous storage slice and hands the whole buffer to the slice
+    /// reduction kernels. Both statically-sized and dynamic matrices qualify, since
+    /// `ArrayStorage` and `VecStorage` are both contiguous; matrix views with a row stride
+    /// are not, and keep the generic path
+    pub trait FastSum<T> {
+        /// The sum of all elements, through one vectorized kernel call
+        fn fast_sum(&self) -> T;
+    }
+
+    /// Vectorized norm and dot product for matrices of the fast types.
+    ///
+    /// See [`FastSum`] for why these bypass the generic nalgebra loops
+    pub trait FastNorm<T> {
+        /// The sum of squared elements, through one vectorized kernel call
+        fn fast_norm_squared(&self) -> T;
+
+        /// The euclidean norm: one vectorized kernel call plus a scalar square root
+        fn fast_norm(&self) -> T;
+
+        /// The elementwise dot product with a matrix of the same shape.
+        ///
+        /// # Panics
+        ///
+        /// Panics if the matrices have different element counts (possible only for
+        /// dynamically-sized matrices)
+        fn fast_dot(&self, other: &Self) -> T;
+    }
+
+    impl<T, R, C, S> FastSum<T> for na::Matrix<T, R, C, S>
+    where
+        T: SliceOps + na::Scalar,
+        R: na::Dim,
+        C: na::Dim,
+        S: na::storage::ContiguousStorage<T, R, C>,
+    {
+        #[inline]
+        fn fast_sum(&self) -> T {
+            slice::sum(self.as_slice())
+        }
+    }
+
+    impl<T, R, C, S> FastNorm<T> for na::Matrix<T, R, C, S>
+    where
+        T: SliceOps + na::ComplexField,
+        R: na::Dim,
+        C: na::Dim,
+        S: na::storage::ContiguousStorage<T, R, C>,
+    {
+        #[inline]
+        fn fast_norm_squared(&self) -> T {
+            let values = self.as_slice();
+            slice::dot(values, values)
+        }
+
+        #[inline]
+        fn fast_norm(&self) -> T {
+            na::ComplexField::sqrt(self.fast_norm_squared())
+        }
+
+        #[inline]
+        fn fast_dot(&self, other: &Self) -> T {
+            slice::dot(self.as_slice(), other.as_slice())
+        }
+    }
 }
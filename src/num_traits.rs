@@ -2,6 +2,8 @@
 #![cfg_attr(docsrs, doc(cfg(feature = "num-traits")))]
 
 use crate::{FF32, FF64};
+use core::num::FpCategory;
+use paste::paste;
 
 macro_rules! forward_freeze_ty {
     ($fast_ty:ident, $base_ty:ident
@@ -189,7 +191,37 @@ macro_rules! impl_num_traits {
             }
         }
 
-        impl num_traits::real::Real for $fast_ty {
+        // num_traits::real::Real comes for free from the blanket `impl<T: Float> Real for T`
+
+        // Float is the gateway to most generic numeric code, so the mapping matters: min, max,
+        // clamp, abs, signum and copysign go to the poison-safe select kernels instead of the
+        // trait's comparison-based defaults, and the non-finite queries answer from the crate's
+        // contract rather than inspecting the value. Only the methods that inherently branch on
+        // the value pay for a freeze: classify, is_normal, is_subnormal, the sign queries,
+        // integer_decode, and the deprecated abs_sub
+        impl num_traits::Float for $fast_ty {
+            // constructors for the values this crate's contract forbids. They exist only to
+            // satisfy the trait; arithmetic on them is unspecified, as it always is
+            #[inline]
+            fn nan() -> Self {
+                <$fast_ty>::new($base_ty::NAN)
+            }
+
+            #[inline]
+            fn infinity() -> Self {
+                <$fast_ty>::new($base_ty::INFINITY)
+            }
+
+            #[inline]
+            fn neg_infinity() -> Self {
+                <$fast_ty>::new($base_ty::NEG_INFINITY)
+            }
+
+            #[inline]
+            fn neg_zero() -> Self {
+                <$fast_ty>::new(-0.0)
+            }
+
             #[inline]
             fn min_value() -> Self {
                 $fast_ty::MIN
@@ -210,8 +242,33 @@ macro_rules! impl_num_traits {
                 <$fast_ty>::new($base_ty::EPSILON)
             }
 
+            // non-finite values are not presented as possibilities, matching the inherent
+            // `classify`; answering with constants also keeps these freeze-free
+            #[inline]
+            fn is_nan(self) -> bool {
+                false
+            }
+
+            #[inline]
+            fn is_infinite(self) -> bool {
+                false
+            }
+
+            #[inline]
+            fn is_finite(self) -> bool {
+                true
+            }
+
             forward_self! {
                 $fast_ty, $base_ty
+                // these branch on the value, so the inherent methods freeze
+                fn classify(self) -> FpCategory;
+                fn is_normal(self) -> bool;
+                fn is_subnormal(self) -> bool;
+                fn is_sign_positive(self) -> bool;
+                fn is_sign_negative(self) -> bool;
+
+                // everything below is freeze-free
                 fn floor(self) -> Self;
                 fn ceil(self) -> Self;
                 fn round(self) -> Self;
@@ -219,8 +276,10 @@ macro_rules! impl_num_traits {
                 fn fract(self) -> Self;
                 fn abs(self) -> Self;
                 fn signum(self) -> Self;
-                fn is_sign_positive(self) -> bool;
-                fn is_sign_negative(self) -> bool;
+                fn copysign(self, sign: Self) -> Self;
+                fn max(self, other: Self) -> Self;
+                fn min(self, other: Self) -> Self;
+                fn clamp(self, min: Self, max: Self) -> Self;
                 fn mul_add(self, a: Self, b: Self) -> Self;
                 fn recip(self) -> Self;
                 fn powi(self, n: i32) -> Self;
@@ -232,8 +291,6 @@ macro_rules! impl_num_traits {
                 fn log(self, base: Self) -> Self;
                 fn log2(self) -> Self;
                 fn log10(self) -> Self;
-                fn max(self, other: Self) -> Self;
-                fn min(self, other: Self) -> Self;
                 fn cbrt(self) -> Self;
                 fn hypot(self, other: Self) -> Self;
                 fn sin(self) -> Self;
@@ -261,9 +318,165 @@ macro_rules! impl_num_traits {
                 #[allow(deprecated)]
                 fn abs_sub(self, other: Self) -> Self;
             }
+
+            #[inline]
+            fn integer_decode(self) -> (u64, i16, i8) {
+                paste! { [<integer_decode_ $base_ty>](self.freeze_raw()) }
+            }
+        }
+
+        // FloatCore is the no_std subset of the above; same kernel mapping and freeze story
+        impl num_traits::float::FloatCore for $fast_ty {
+            #[inline]
+            fn nan() -> Self {
+                <$fast_ty>::new($base_ty::NAN)
+            }
+
+            #[inline]
+            fn infinity() -> Self {
+                <$fast_ty>::new($base_ty::INFINITY)
+            }
+
+            #[inline]
+            fn neg_infinity() -> Self {
+                <$fast_ty>::new($base_ty::NEG_INFINITY)
+            }
+
+            #[inline]
+            fn neg_zero() -> Self {
+                <$fast_ty>::new(-0.0)
+            }
+
+            #[inline]
+            fn min_value() -> Self {
+                $fast_ty::MIN
+            }
+
+            #[inline]
+            fn min_positive_value() -> Self {
+                $fast_ty::MIN_POSITIVE
+            }
+
+            #[inline]
+            fn max_value() -> Self {
+                $fast_ty::MAX
+            }
+
+            #[inline]
+            fn epsilon() -> Self {
+                <$fast_ty>::new($base_ty::EPSILON)
+            }
+
+            #[inline]
+            fn is_nan(self) -> bool {
+                false
+            }
+
+            #[inline]
+            fn is_infinite(self) -> bool {
+                false
+            }
+
+            #[inline]
+            fn is_finite(self) -> bool {
+                true
+            }
+
+            forward_self! {
+                $fast_ty, $base_ty
+                fn classify(self) -> FpCategory;
+                fn is_normal(self) -> bool;
+                fn is_subnormal(self) -> bool;
+                fn is_sign_positive(self) -> bool;
+                fn is_sign_negative(self) -> bool;
+
+                fn floor(self) -> Self;
+                fn ceil(self) -> Self;
+                fn round(self) -> Self;
+                fn trunc(self) -> Self;
+                fn fract(self) -> Self;
+                fn abs(self) -> Self;
+                fn signum(self) -> Self;
+                fn max(self, other: Self) -> Self;
+                fn min(self, other: Self) -> Self;
+                fn clamp(self, min: Self, max: Self) -> Self;
+                fn recip(self) -> Self;
+                fn powi(self, n: i32) -> Self;
+                fn to_degrees(self) -> Self;
+                fn to_radians(self) -> Self;
+            }
+
+            #[inline]
+            fn integer_decode(self) -> (u64, i16, i8) {
+                paste! { [<integer_decode_ $base_ty>](self.freeze_raw()) }
+            }
         }
     };
 }
 
+// integer_decode is specified in terms of the IEEE bit layout, so it gets one definition per
+// base type instead of a forwarding macro
+#[inline]
+fn integer_decode_f32(f: f32) -> (u64, i16, i8) {
+    let bits = f.to_bits();
+    let sign = if bits >> 31 == 0 { 1 } else { -1 };
+    let mut exponent = ((bits >> 23) & 0xff) as i16;
+    let mantissa = if exponent == 0 {
+        (bits & 0x7f_ffff) << 1
+    } else {
+        (bits & 0x7f_ffff) | 0x80_0000
+    };
+    exponent -= 127 + 23;
+    (mantissa as u64, exponent, sign)
+}
+
+#[inline]
+fn integer_decode_f64(f: f64) -> (u64, i16, i8) {
+    let bits = f.to_bits();
+    let sign = if bits >> 63 == 0 { 1 } else { -1 };
+    let mut exponent = ((bits >> 52) & 0x7ff) as i16;
+    let mantissa = if exponent == 0 {
+        (bits & 0xf_ffff_ffff_ffff) << 1
+    } else {
+        (bits & 0xf_ffff_ffff_ffff) | 0x10_0000_0000_0000
+    };
+    exponent -= 1023 + 52;
+    (mantissa, exponent, sign)
+}
+
 impl_num_traits! { FF32, f32 }
 impl_num_traits! { FF64, f64 }
+
+// the wide types only carry the identity traits; the rest of the numeric tower is lane-scalar
+// territory
+macro_rules! impl_num_traits_wide {
+    ($($wide_ty:ident;)*) => {
+        $(
+            impl num_traits::One for crate::$wide_ty {
+                #[inline(always)]
+                fn one() -> Self {
+                    Self::splat(1.0)
+                }
+
+                #[inline]
+                fn is_one(&self) -> bool {
+                    self.to_array() == [1.0; crate::$wide_ty::LANES]
+                }
+            }
+
+            impl num_traits::Zero for crate::$wide_ty {
+                #[inline(always)]
+                fn zero() -> Self {
+                    Self::splat(0.0)
+                }
+
+                #[inline]
+                fn is_zero(&self) -> bool {
+                    self.to_array() == [0.0; crate::$wide_ty::LANES]
+                }
+            }
+        )*
+    };
+}
+
+impl_num_traits_wide! { FF32x4; FF32x8; FF64x2; FF64x4; }
@@ -0,0 +1,135 @@
+#![cfg(feature = "rayon")]
+#![cfg_attr(docsrs, doc(cfg(feature = "rayon")))]
+
+//! Parallel reductions and elementwise maps over slices of the fast types.
+//!
+//! Splitting a reduction into per-thread partial accumulators is the same reassociation
+//! fast-math already permits, so these produce results equivalent (up to the usual fast-math
+//! caveats) to their serial counterparts in [`crate::slice`], which they use for the per-chunk
+//! work.
+
+use crate::slice::{self, SliceOps};
+use crate::{FF32, FF64};
+use rayon::prelude::*;
+
+// chunks below this size aren't worth a task: the per-chunk kernel call and join overhead
+// outweighs the arithmetic
+const MIN_CHUNK: usize = 16 * 1024;
+
+/// A scalar fast type usable with the parallel operations in this module.
+///
+/// Implemented only by [`FF32`] and [`FF64`]; the methods are an implementation detail of the
+/// module-level functions
+pub trait ParOps: SliceOps + Send + Sync {
+    #[doc(hidden)]
+    fn zero() -> Self;
+    #[doc(hidden)]
+    fn one() -> Self;
+    #[doc(hidden)]
+    fn add_scalar(self, other: Self) -> Self;
+    #[doc(hidden)]
+    fn mul_scalar(self, other: Self) -> Self;
+    #[doc(hidden)]
+    fn min_scalar(self, other: Self) -> Self;
+    #[doc(hidden)]
+    fn max_scalar(self, other: Self) -> Self;
+}
+
+macro_rules! impl_par_ops {
+    ($($fast_ty:ident,)*) => {
+        $(
+            impl ParOps for $fast_ty {
+                #[inline(always)]
+                fn zero() -> Self {
+                    <$fast_ty>::new(0.0)
+                }
+
+                #[inline(always)]
+                fn one() -> Self {
+                    <$fast_ty>::new(1.0)
+                }
+
+                #[inline(always)]
+                fn add_scalar(self, other: Self) -> Self {
+                    self + other
+                }
+
+                #[inline(always)]
+                fn mul_scalar(self, other: Self) -> Self {
+                    self * other
+                }
+
+                #[inline(always)]
+                fn min_scalar(self, other: Self) -> Self {
+                    self.min(other)
+                }
+
+                #[inline(always)]
+                fn max_scalar(self, other: Self) -> Self {
+                    self.max(other)
+                }
+            }
+        )*
+    };
+}
+
+impl_par_ops! { FF32, FF64, }
+
+/// Sum all elements in parallel, returning zero for an empty slice.
+///
+/// Each thread reduces its chunks with [`slice::sum`] and the partial sums are combined with
+/// the fast add
+pub fn par_sum<T: ParOps>(values: &[T]) -> T {
+    values
+        .par_chunks(MIN_CHUNK)
+        .map(slice::sum)
+        .reduce(T::zero, T::add_scalar)
+}
+
+/// Multiply all elements in parallel, returning one for an empty slice
+pub fn par_product<T: ParOps>(values: &[T]) -> T {
+    values
+        .par_chunks(MIN_CHUNK)
+        .map(slice::product)
+        .reduce(T::one, T::mul_scalar)
+}
+
+/// The dot product of the two slices computed in parallel, zero if they are empty.
+///
+/// # Panics
+///
+/// Panics if the slices have different lengths
+pub fn par_dot<T: ParOps>(a: &[T], b: &[T]) -> T {
+    assert_eq!(a.len(), b.len());
+    a.par_chunks(MIN_CHUNK)
+        .zip(b.par_chunks(MIN_CHUNK))
+        .map(|(a, b)| slice::dot(a, b))
+        .reduce(T::zero, T::add_scalar)
+}
+
+/// The minimum and maximum elements computed in one parallel pass, or `None` if the slice is
+/// empty
+pub fn par_min_max<T: ParOps>(values: &[T]) -> Option<(T, T)> {
+    values
+        .par_chunks(MIN_CHUNK)
+        .map(|chunk| {
+            // chunks are non-empty, so the per-chunk min/max always exist
+            (slice::min(chunk).unwrap(), slice::max(chunk).unwrap())
+        })
+        .reduce_with(|(min_a, max_a), (min_b, max_b)| {
+            (min_a.min_scalar(min_b), max_a.max_scalar(max_b))
+        })
+}
+
+/// Apply `op` to every element in place, in parallel
+pub fn par_map_inplace<T, F>(values: &mut [T], op: F)
+where
+    T: ParOps,
+    F: Fn(T) -> T + Send + Sync,
+{
+    values.par_chunks_mut(MIN_CHUNK).for_each(|chunk| {
+        for value in chunk {
+            *value = op(*value);
+        }
+    });
+}
@@ -8,4 +8,37 @@ define double @freeze_f64(double %a) unnamed_addr #0 {
   ret double %b
 }
 
+; vector freezes operate in place through a pointer, so the rust callers don't
+; depend on the ABI of vector types across the FFI boundary. The loads and
+; stores are element-aligned because the rust wrappers are only element-aligned.
+
+define void @freeze_f32x4(<4 x float>* nocapture %p) unnamed_addr #1 {
+  %a = load <4 x float>, <4 x float>* %p, align 4
+  %b = freeze <4 x float> %a
+  store <4 x float> %b, <4 x float>* %p, align 4
+  ret void
+}
+
+define void @freeze_f32x8(<8 x float>* nocapture %p) unnamed_addr #1 {
+  %a = load <8 x float>, <8 x float>* %p, align 4
+  %b = freeze <8 x float> %a
+  store <8 x float> %b, <8 x float>* %p, align 4
+  ret void
+}
+
+define void @freeze_f64x2(<2 x double>* nocapture %p) unnamed_addr #1 {
+  %a = load <2 x double>, <2 x double>* %p, align 8
+  %b = freeze <2 x double> %a
+  store <2 x double> %b, <2 x double>* %p, align 8
+  ret void
+}
+
+define void @freeze_f64x4(<4 x double>* nocapture %p) unnamed_addr #1 {
+  %a = load <4 x double>, <4 x double>* %p, align 8
+  %b = freeze <4 x double> %a
+  store <4 x double> %b, <4 x double>* %p, align 8
+  ret void
+}
+
 attributes #0 = { alwaysinline nofree norecurse willreturn nosync nounwind readnone }
+attributes #1 = { alwaysinline nofree norecurse willreturn nosync nounwind argmemonly }
@@ -23,16 +23,29 @@ impl<T> MaybePoison<T> {
 macro_rules! impl_freeze {
     ($($raw_ty:ty, $fn_name:ident;)*) => {
         $(
+            #[cfg(not(feature = "fallback"))]
             #[link(name = "freeze")]
             extern "C" {
                 fn $fn_name(val: MaybePoison<$raw_ty>) -> $raw_ty;
             }
 
             impl MaybePoison<$raw_ty> {
+                #[cfg(not(feature = "fallback"))]
                 #[inline(always)]
                 pub(crate) fn freeze(self) -> $raw_ty {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_freeze();
                     unsafe { $fn_name(self) }
                 }
+
+                // with the fallback backend none of the fast-math compiled libraries are
+                // linked, so no operation can produce poison and the stored value is always
+                // concrete
+                #[cfg(feature = "fallback")]
+                #[inline(always)]
+                pub(crate) fn freeze(self) -> $raw_ty {
+                    unsafe { self.0.assume_init() }
+                }
             }
         )*
     }
@@ -42,3 +55,84 @@ impl_freeze! {
     f32, freeze_f32;
     f64, freeze_f64;
 }
+
+macro_rules! impl_freeze_wide {
+    ($($raw_ty:ty, $lanes:expr, $fn_name:ident;)*) => {
+        $(
+            #[cfg(not(feature = "fallback"))]
+            #[link(name = "freeze")]
+            extern "C" {
+                // the vector freezes work in place through a pointer, so no assumptions are made
+                // about the ABI of vector types across the FFI boundary
+                fn $fn_name(val: *mut MaybePoison<[$raw_ty; $lanes]>);
+            }
+
+            impl MaybePoison<[$raw_ty; $lanes]> {
+                #[cfg(not(feature = "fallback"))]
+                #[inline(always)]
+                pub(crate) fn freeze(mut self) -> [$raw_ty; $lanes] {
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_freeze();
+                    unsafe {
+                        $fn_name(&mut self);
+                        // every lane was just frozen to a concrete value
+                        self.0.assume_init()
+                    }
+                }
+
+                // see the scalar fallback freeze above: no poison can exist in this mode
+                #[cfg(feature = "fallback")]
+                #[inline(always)]
+                pub(crate) fn freeze(self) -> [$raw_ty; $lanes] {
+                    unsafe { self.0.assume_init() }
+                }
+            }
+        )*
+    }
+}
+
+impl_freeze_wide! {
+    f32, 4, freeze_f32x4;
+    f32, 8, freeze_f32x8;
+    f64, 2, freeze_f64x2;
+    f64, 4, freeze_f64x4;
+}
+
+macro_rules! impl_freeze_slice {
+    ($($raw_ty:ty, $lanes:expr, $wide_fn:ident, $slice_fn:ident;)*) => {
+        $(
+            /// Freeze every element of the slice in place.
+            ///
+            /// No poison can exist with the fallback backend, so there is nothing to do
+            #[cfg(feature = "fallback")]
+            #[inline]
+            pub(crate) fn $slice_fn(_values: &mut [MaybePoison<$raw_ty>]) {}
+
+            /// Freeze every element of the slice in place, using the vector freeze for the bulk
+            /// of the buffer and the scalar freeze for the tail
+            #[cfg(not(feature = "fallback"))]
+            #[inline]
+            pub(crate) fn $slice_fn(values: &mut [MaybePoison<$raw_ty>]) {
+                let mut chunks = values.chunks_exact_mut($lanes);
+                for chunk in &mut chunks {
+                    // each vector chunk is one freeze event, like the scalar and wide calls
+                    #[cfg(feature = "profiling")]
+                    crate::profiling::count_freeze();
+                    // a chunk of $lanes contiguous MaybePoison<T> has the same layout as one
+                    // MaybePoison<[T; $lanes]>
+                    unsafe {
+                        $wide_fn(chunk.as_mut_ptr() as *mut MaybePoison<[$raw_ty; $lanes]>)
+                    }
+                }
+                for val in chunks.into_remainder() {
+                    *val = MaybePoison::new(val.freeze());
+                }
+            }
+        )*
+    }
+}
+
+impl_freeze_slice! {
+    f32, 8, freeze_f32x8, freeze_slice_f32;
+    f64, 4, freeze_f64x4, freeze_slice_f64;
+}
@@ -0,0 +1,129 @@
+#![cfg(feature = "profiling")]
+#![cfg_attr(docsrs, doc(cfg(feature = "profiling")))]
+
+//! Opt-in accounting of which path the fast-type operations resolve through.
+//!
+//! The README warns that the fast types can underperform the primitives, and the usual cause
+//! is freezing: every comparison, conversion out, and `poison_unsafe` call freezes its
+//! operands, and a module doing mostly comparisons pays more for freezes than it gains from
+//! the fast kernels. This module counts three categories from the inside -- operations
+//! resolved through the poison-safe fast kernels, operations routed through the freezing
+//! `poison_unsafe` wrappers, and raw freeze invocations -- so the freeze-per-fast-op ratio
+//! of a workload can be measured instead of inferred from disassembly.
+//!
+//! The hot-path hook is one increment of a plain thread-local counter; threads flush into
+//! the global totals when they exit (and on a coarse threshold in between), and [`report`]
+//! flushes the calling thread before reading, so counts from other still-running threads may
+//! lag by up to the flush threshold. With the feature disabled none of the hooks exist.
+
+use core::cell::Cell;
+use core::sync::atomic::{AtomicU64, Ordering::Relaxed};
+
+static FAST_OPS: AtomicU64 = AtomicU64::new(0);
+static FROZEN_OPS: AtomicU64 = AtomicU64::new(0);
+static FREEZES: AtomicU64 = AtomicU64::new(0);
+
+// flush to the globals after this many locally-recorded events, so long-running threads
+// stay roughly visible in reports without touching shared cache lines per operation
+const FLUSH_THRESHOLD: u64 = 1 << 20;
+
+thread_local! {
+    static LOCAL: LocalCounters = LocalCounters::default();
+}
+
+#[derive(Default)]
+struct LocalCounters {
+    fast_ops: Cell<u64>,
+    frozen_ops: Cell<u64>,
+    freezes: Cell<u64>,
+}
+
+impl LocalCounters {
+    fn flush(&self) {
+        FAST_OPS.fetch_add(self.fast_ops.take(), Relaxed);
+        FROZEN_OPS.fetch_add(self.frozen_ops.take(), Relaxed);
+        FREEZES.fetch_add(self.freezes.take(), Relaxed);
+    }
+}
+
+impl Drop for LocalCounters {
+    fn drop(&mut self) {
+        self.flush();
+    }
+}
+
+/// A snapshot of the operation counters
+#[derive(Debug, Clone, Copy)]
+pub struct Report {
+    /// Operations resolved through the poison-safe fast kernels (arithmetic, min/max/clamp,
+    /// selects, fused multiply-adds)
+    pub fast_ops: u64,
+    /// Operations routed through the freezing `poison_unsafe` wrappers (the transcendental
+    /// functions); their operand freezes are additionally included in [`freezes`](Report::freezes)
+    pub frozen_ops: u64,
+    /// Raw freeze invocations: one per scalar or vector freeze call, whether from
+    /// comparisons, conversions out, `poison_unsafe` operands, or batch freeze chunks
+    pub freezes: u64,
+}
+
+impl Report {
+    /// Freezes per fast-kernel operation: the single most telling number for whether a
+    /// workload should be using the fast types at all. Well below one, the fast kernels
+    /// dominate and the types are winning; near or above one, freezing is eating the gains
+    /// and the module is likely comparison- or conversion-bound
+    pub fn freeze_ratio(&self) -> f64 {
+        self.freezes as f64 / (self.fast_ops.max(1)) as f64
+    }
+}
+
+/// A snapshot of the counters accumulated since startup (or the last [`reset`]).
+///
+/// The calling thread's local counters are flushed first; other live threads' most recent
+/// events may not be included until they flush
+pub fn report() -> Report {
+    LOCAL.with(LocalCounters::flush);
+    Report {
+        fast_ops: FAST_OPS.load(Relaxed),
+        frozen_ops: FROZEN_OPS.load(Relaxed),
+        freezes: FREEZES.load(Relaxed),
+    }
+}
+
+/// Reset the global counters (thread-local counts not yet flushed are unaffected)
+pub fn reset() {
+    FAST_OPS.store(0, Relaxed);
+    FROZEN_OPS.store(0, Relaxed);
+    FREEZES.store(0, Relaxed);
+}
+
+// the hot-path hooks: one thread-local increment each, plus a predictable threshold branch
+
+#[inline(always)]
+pub(crate) fn count_fast_op() {
+    LOCAL.with(|local| {
+        bump(local, &local.fast_ops);
+    });
+}
+
+#[inline(always)]
+pub(crate) fn count_frozen_op() {
+    LOCAL.with(|local| {
+        bump(local, &local.frozen_ops);
+    });
+}
+
+#[inline(always)]
+pub(crate) fn count_freeze() {
+    LOCAL.with(|local| {
+        bump(local, &local.freezes);
+    });
+}
+
+#[inline(always)]
+fn bump(local: &LocalCounters, counter: &Cell<u64>) {
+    let n = counter.get() + 1;
+    counter.set(n);
+    if n >= FLUSH_THRESHOLD {
+        local.flush();
+    }
+}
@@ -0,0 +1,428 @@
+//! Reduction operations over slices of the fast types.
+//!
+//! The `Sum`/`Product` impls on the scalar types fold element by element, which serializes the
+//! dependency chain unless the optimizer happens to see through the whole loop. The functions in
+//! this module instead hand the entire buffer to a single fast-math compiled kernel, which is
+//! free to reassociate the reduction into multi-lane partial accumulators.
+
+use crate::{FF32, FF64};
+use paste::paste;
+
+#[cfg(feature = "fallback")]
+use crate::math::fallback::*;
+
+mod sealed {
+    pub trait Sealed {}
+    impl Sealed for crate::FF32 {}
+    impl Sealed for crate::FF64 {}
+}
+
+/// A scalar fast type whose slices can be processed by the kernels in this module.
+///
+/// This trait is sealed and implemented only by [`FF32`] and [`FF64`]; its methods are an
+/// implementation detail of the module-level functions
+pub trait SliceOps: sealed::Sealed + Copy {
+    /// The primitive type this fast type wraps
+    type Base: Copy;
+
+    #[doc(hidden)]
+    fn freeze_slice(values: &[Self]) -> Vec<Self::Base>;
+    #[doc(hidden)]
+    fn freeze_slice_in_place(values: &mut [Self]) -> &mut [Self::Base];
+    #[doc(hidden)]
+    fn sum_slice(values: &[Self]) -> Self;
+    #[doc(hidden)]
+    fn product_slice(values: &[Self]) -> Self;
+    #[doc(hidden)]
+    fn dot_slice(a: &[Self], b: &[Self]) -> Self;
+    #[doc(hidden)]
+    fn min_slice(values: &[Self]) -> Option<Self>;
+    #[doc(hidden)]
+    fn max_slice(values: &[Self]) -> Option<Self>;
+    #[doc(hidden)]
+    fn poly_eval_slice(coeffs: &[Self], xs: &[Self], out: &mut [Self]);
+    #[doc(hidden)]
+    fn prefix_sum_slice_in_place(values: &mut [Self]);
+    #[doc(hidden)]
+    fn cummax_slice_in_place(values: &mut [Self]);
+    #[doc(hidden)]
+    fn sort_unstable_frozen(values: &mut [Self::Base]);
+    #[doc(hidden)]
+    fn select_nth_unstable_frozen(values: &mut [Self::Base], index: usize);
+    #[doc(hidden)]
+    fn exp_slice_in_place(values: &mut [Self]);
+    #[doc(hidden)]
+    fn ln_slice_in_place(values: &mut [Self]);
+    #[doc(hidden)]
+    fn sin_slice_in_place(values: &mut [Self]);
+    #[doc(hidden)]
+    fn cos_slice_in_place(values: &mut [Self]);
+    #[doc(hidden)]
+    fn tanh_slice_in_place(values: &mut [Self]);
+}
+
+macro_rules! impl_slice_reductions {
+    (@transcendental $base_ty:ident: $($trait_fn:ident, $kernel:ident,)*) => {
+        $(
+            #[inline]
+            fn $trait_fn(values: &mut [Self]) {
+                // one vectorized freeze pass, then the kernel runs in place on the concrete
+                // values
+                let frozen = Self::freeze_slice_in_place(values);
+                unsafe { $kernel(frozen.as_mut_ptr(), frozen.len()) }
+            }
+        )*
+    };
+
+    ($fast_ty:ident, $base_ty:ident, $frozen_ty:ident) => {
+        paste! {
+            #[cfg(not(feature = "fallback"))]
+            #[link(name = "poison_safe")]
+            extern "C" {
+                // like the scalar poison safe kernels, these can accept (and may produce) poison
+                // values without UB; the slice contents are passed by pointer and never inspected
+                // on the rust side
+                fn [<sum_slice_ $base_ty>](ptr: *const $fast_ty, len: usize) -> $fast_ty;
+                fn [<product_slice_ $base_ty>](ptr: *const $fast_ty, len: usize) -> $fast_ty;
+                fn [<dot_slice_ $base_ty>](
+                    a: *const $fast_ty,
+                    b: *const $fast_ty,
+                    len: usize,
+                ) -> $fast_ty;
+                fn [<min_slice_ $base_ty>](ptr: *const $fast_ty, len: usize) -> $fast_ty;
+                fn [<max_slice_ $base_ty>](ptr: *const $fast_ty, len: usize) -> $fast_ty;
+                fn [<poly_eval_slice_ $base_ty>](
+                    coeffs: *const $fast_ty,
+                    n: usize,
+                    xs: *const $fast_ty,
+                    out: *mut $fast_ty,
+                    len: usize,
+                );
+                fn [<prefix_sum_slice_ $base_ty>](ptr: *mut $fast_ty, len: usize);
+                fn [<cummax_slice_ $base_ty>](ptr: *mut $fast_ty, len: usize);
+            }
+
+            #[cfg(not(feature = "fallback"))]
+            #[link(name = "poison_unsafe")]
+            extern "C" {
+                // in-place transcendental kernels; the buffer must be frozen before the call,
+                // which the trait impls below do in one vectorized pass
+                fn [<exp_slice_ $base_ty>](ptr: *mut $base_ty, len: usize);
+                fn [<ln_slice_ $base_ty>](ptr: *mut $base_ty, len: usize);
+                fn [<sin_slice_ $base_ty>](ptr: *mut $base_ty, len: usize);
+                fn [<cos_slice_ $base_ty>](ptr: *mut $base_ty, len: usize);
+                fn [<tanh_slice_ $base_ty>](ptr: *mut $base_ty, len: usize);
+            }
+
+            impl SliceOps for $fast_ty {
+                type Base = $base_ty;
+
+                #[inline]
+                fn freeze_slice(values: &[Self]) -> Vec<$base_ty> {
+                    let mut out: Vec<Self> = values.to_vec();
+                    Self::freeze_slice_in_place(&mut out);
+                    // the fast type is (transitively) repr(transparent) over the primitive, so
+                    // the vec's buffer can be reused as-is
+                    let mut out = core::mem::ManuallyDrop::new(out);
+                    unsafe {
+                        Vec::from_raw_parts(
+                            out.as_mut_ptr() as *mut $base_ty,
+                            out.len(),
+                            out.capacity(),
+                        )
+                    }
+                }
+
+                #[inline]
+                fn freeze_slice_in_place(values: &mut [Self]) -> &mut [$base_ty] {
+                    // the fast type is repr(transparent) over MaybePoison of the primitive
+                    let poison = unsafe {
+                        &mut *(values as *mut [Self] as *mut [crate::poison::MaybePoison<$base_ty>])
+                    };
+                    crate::poison::[<freeze_slice_ $base_ty>](poison);
+                    // every element is now a concrete, non-poison value, so the primitive view
+                    // can be handed out safely
+                    unsafe { &mut *(poison as *mut [crate::poison::MaybePoison<$base_ty>] as *mut [$base_ty]) }
+                }
+
+                #[inline]
+                fn sum_slice(values: &[Self]) -> Self {
+                    unsafe { [<sum_slice_ $base_ty>](values.as_ptr(), values.len()) }
+                }
+
+                #[inline]
+                fn product_slice(values: &[Self]) -> Self {
+                    unsafe { [<product_slice_ $base_ty>](values.as_ptr(), values.len()) }
+                }
+
+                #[inline]
+                fn dot_slice(a: &[Self], b: &[Self]) -> Self {
+                    unsafe { [<dot_slice_ $base_ty>](a.as_ptr(), b.as_ptr(), a.len()) }
+                }
+
+                #[inline]
+                fn min_slice(values: &[Self]) -> Option<Self> {
+                    if values.is_empty() {
+                        None
+                    } else {
+                        Some(unsafe { [<min_slice_ $base_ty>](values.as_ptr(), values.len()) })
+                    }
+                }
+
+                #[inline]
+                fn max_slice(values: &[Self]) -> Option<Self> {
+                    if values.is_empty() {
+                        None
+                    } else {
+                        Some(unsafe { [<max_slice_ $base_ty>](values.as_ptr(), values.len()) })
+                    }
+                }
+
+                #[inline]
+                fn prefix_sum_slice_in_place(values: &mut [Self]) {
+                    unsafe { [<prefix_sum_slice_ $base_ty>](values.as_mut_ptr(), values.len()) }
+                }
+
+                #[inline]
+                fn cummax_slice_in_place(values: &mut [Self]) {
+                    unsafe { [<cummax_slice_ $base_ty>](values.as_mut_ptr(), values.len()) }
+                }
+
+                #[inline]
+                fn sort_unstable_frozen(values: &mut [$base_ty]) {
+                    // the frozen wrapper is repr(transparent) over the primitive, and its Ord
+                    // is the total order of the already-frozen bits, so the sort makes no
+                    // further FFI calls
+                    let frozen = unsafe {
+                        &mut *(values as *mut [$base_ty] as *mut [crate::$frozen_ty])
+                    };
+                    frozen.sort_unstable();
+                }
+
+                #[inline]
+                fn select_nth_unstable_frozen(values: &mut [$base_ty], index: usize) {
+                    let frozen = unsafe {
+                        &mut *(values as *mut [$base_ty] as *mut [crate::$frozen_ty])
+                    };
+                    frozen.select_nth_unstable(index);
+                }
+
+                #[inline]
+                fn poly_eval_slice(coeffs: &[Self], xs: &[Self], out: &mut [Self]) {
+                    unsafe {
+                        [<poly_eval_slice_ $base_ty>](
+                            coeffs.as_ptr(),
+                            coeffs.len(),
+                            xs.as_ptr(),
+                            out.as_mut_ptr(),
+                            xs.len(),
+                        )
+                    }
+                }
+
+                impl_slice_reductions! {
+                    @transcendental $base_ty:
+                    exp_slice_in_place, [<exp_slice_ $base_ty>],
+                    ln_slice_in_place, [<ln_slice_ $base_ty>],
+                    sin_slice_in_place, [<sin_slice_ $base_ty>],
+                    cos_slice_in_place, [<cos_slice_ $base_ty>],
+                    tanh_slice_in_place, [<tanh_slice_ $base_ty>],
+                }
+            }
+        }
+    };
+}
+
+impl_slice_reductions! { FF32, f32, Frozen32 }
+impl_slice_reductions! { FF64, f64, Frozen64 }
+
+/// Freeze every element once and return the concrete primitive values.
+///
+/// Freezing has a nontrivial cost per call, and comparison-heavy code (sorting, percentiles)
+/// pays it on every single comparison. Freezing the whole buffer up front instead amortizes the
+/// cost to one vectorized pass
+#[inline]
+pub fn freeze<T: SliceOps>(values: &[T]) -> Vec<T::Base> {
+    T::freeze_slice(values)
+}
+
+/// Freeze every element of the slice in place, returning a view of the concrete primitives.
+///
+/// The returned slice aliases the input buffer; no copy is made. See [`freeze`] for why batch
+/// freezing is useful
+#[inline]
+pub fn freeze_in_place<T: SliceOps>(values: &mut [T]) -> &mut [T::Base] {
+    T::freeze_slice_in_place(values)
+}
+
+/// Sum all elements of the slice, returning zero for an empty slice.
+///
+/// Unlike `iter().sum()`, the whole reduction runs inside one fast-math kernel which may
+/// reassociate it into vectorized partial sums
+#[inline]
+pub fn sum<T: SliceOps>(values: &[T]) -> T {
+    T::sum_slice(values)
+}
+
+/// Multiply all elements of the slice, returning one for an empty slice
+#[inline]
+pub fn product<T: SliceOps>(values: &[T]) -> T {
+    T::product_slice(values)
+}
+
+/// The dot product of the two slices, zero if they are empty.
+///
+/// # Panics
+///
+/// Panics if the slices have different lengths
+#[inline]
+pub fn dot<T: SliceOps>(a: &[T], b: &[T]) -> T {
+    assert_eq!(a.len(), b.len());
+    T::dot_slice(a, b)
+}
+
+/// The minimum element of the slice, or `None` if it is empty.
+///
+/// The comparisons compile to selects inside the kernel, so no freezing is involved
+#[inline]
+pub fn min<T: SliceOps>(values: &[T]) -> Option<T> {
+    T::min_slice(values)
+}
+
+/// The maximum element of the slice, or `None` if it is empty.
+///
+/// The comparisons compile to selects inside the kernel, so no freezing is involved
+#[inline]
+pub fn max<T: SliceOps>(values: &[T]) -> Option<T> {
+    T::max_slice(values)
+}
+
+/// Sort the slice in place, freezing every element exactly once.
+///
+/// Sorting through the fast types' `PartialOrd` pays two freeze FFI calls per comparison; this
+/// freezes the buffer in one vectorized pass and then sorts the fixed bits by their IEEE 754
+/// total order, which for the finite values this crate's contract requires matches the usual
+/// numeric order (except that `-0.0` sorts before `+0.0`)
+#[inline]
+pub fn sort_unstable<T: SliceOps>(values: &mut [T]) {
+    let frozen = T::freeze_slice_in_place(values);
+    T::sort_unstable_frozen(frozen);
+}
+
+/// Partially sort the slice so that the element at `index` is at its final sorted position,
+/// with smaller elements before it and larger ones after, and return it.
+///
+/// Like [`sort_unstable`], the buffer is frozen once up front and the selection runs on the
+/// fixed bits; this is the building block for percentile and median extraction
+///
+/// # Panics
+///
+/// Panics if `index` is out of bounds
+#[inline]
+pub fn select_nth_unstable<T: SliceOps>(values: &mut [T], index: usize) -> T {
+    let frozen = T::freeze_slice_in_place(values);
+    T::select_nth_unstable_frozen(frozen, index);
+    values[index]
+}
+
+/// Evaluate one polynomial across a slice of inputs, writing the results into `out`.
+///
+/// `coeffs` is ordered highest degree first, as in the scalar `poly_eval`. The per-input Horner
+/// recurrences are independent, so the kernel evaluates several inputs per vector lane
+///
+/// # Panics
+///
+/// Panics if `xs` and `out` have different lengths
+#[inline]
+pub fn poly_eval<T: SliceOps>(coeffs: &[T], xs: &[T], out: &mut [T]) {
+    assert_eq!(xs.len(), out.len());
+    T::poly_eval_slice(coeffs, xs, out);
+}
+
+/// Replace each element with the sum of itself and all elements before it (an inclusive scan).
+///
+/// An element-by-element `cumsum` is one long dependence chain, one add per element. Fast-math
+/// reassociation lets the kernel restructure the scan into blocks combined at logarithmic
+/// depth, so the loop-carried dependence shrinks to one add per block
+#[inline]
+pub fn prefix_sum_in_place<T: SliceOps>(values: &mut [T]) {
+    T::prefix_sum_slice_in_place(values);
+}
+
+/// Write the inclusive prefix sum of `values` into `out`.
+///
+/// See [`prefix_sum_in_place`] for the scan rationale
+///
+/// # Panics
+///
+/// Panics if `values` and `out` have different lengths
+#[inline]
+pub fn prefix_sum<T: SliceOps>(values: &[T], out: &mut [T]) {
+    assert_eq!(values.len(), out.len());
+    out.copy_from_slice(values);
+    T::prefix_sum_slice_in_place(out);
+}
+
+/// Replace each element with the maximum of itself and all elements before it.
+///
+/// Like the [`max`] reduction, the comparisons compile to selects inside the kernel, so no
+/// freezing is involved; the scan is blocked the same way as [`prefix_sum_in_place`]
+#[inline]
+pub fn cummax_in_place<T: SliceOps>(values: &mut [T]) {
+    T::cummax_slice_in_place(values);
+}
+
+/// Write the cumulative maximum of `values` into `out`.
+///
+/// # Panics
+///
+/// Panics if `values` and `out` have different lengths
+#[inline]
+pub fn cummax<T: SliceOps>(values: &[T], out: &mut [T]) {
+    assert_eq!(values.len(), out.len());
+    out.copy_from_slice(values);
+    T::cummax_slice_in_place(out);
+}
+
+macro_rules! slice_transcendental_fns {
+    ($($fn_name:ident, $in_place_fn:ident, $trait_fn:ident;)*) => {
+        $(
+            #[doc = "Apply `"]
+            #[doc = stringify!($fn_name)]
+            #[doc = "` to every element, writing the results into `out`."]
+            ///
+            /// The whole batch pays one vectorized freeze pass and one kernel call, instead of
+            /// a freeze and an FFI call per element. The evaluation inside the kernel is still
+            /// one scalar libm call per element; the saving is the amortized freeze and call
+            /// overhead
+            ///
+            /// # Panics
+            ///
+            /// Panics if `values` and `out` have different lengths
+            #[inline]
+            pub fn $fn_name<T: SliceOps>(values: &[T], out: &mut [T]) {
+                assert_eq!(values.len(), out.len());
+                out.copy_from_slice(values);
+                T::$trait_fn(out);
+            }
+
+            #[doc = "Apply `"]
+            #[doc = stringify!($fn_name)]
+            #[doc = "` to every element in place."]
+            ///
+            /// See the out-of-place variant for the batching rationale
+            #[inline]
+            pub fn $in_place_fn<T: SliceOps>(values: &mut [T]) {
+                T::$trait_fn(values);
+            }
+        )*
+    };
+}
+
+slice_transcendental_fns! {
+    exp, exp_in_place, exp_slice_in_place;
+    ln, ln_in_place, ln_slice_in_place;
+    sin, sin_in_place, sin_slice_in_place;
+    cos, cos_in_place, cos_slice_in_place;
+    tanh, tanh_in_place, tanh_slice_in_place;
+}
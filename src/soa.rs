@@ -0,0 +1,247 @@
+//! Structure-of-arrays storage for batches of 3-component points and vectors.
+//!
+//! An array of `Point3<FF32>` interleaves `x`, `y` and `z` at a 12-byte stride, which defeats
+//! vectorization of batch geometry: every lane gather crosses components. [`SoaVec3`] stores
+//! each component in its own contiguous buffer instead, so the batch operations below compile
+//! to unit-stride vector loads and fused multiply-adds over the fast types.
+
+use crate::slice::SliceOps;
+use crate::{FF32, FF64};
+use core::ops::{Add, Mul, Sub};
+
+/// A scalar fast type usable as the component type of [`SoaVec3`].
+///
+/// Implemented only by [`FF32`] and [`FF64`]; the methods are an implementation detail of the
+/// container's batch operations
+pub trait SoaOps:
+    SliceOps + Add<Output = Self> + Sub<Output = Self> + Mul<Output = Self>
+{
+    #[doc(hidden)]
+    fn mul_add(self, mul: Self, add: Self) -> Self;
+    #[doc(hidden)]
+    fn rsqrt(self) -> Self;
+}
+
+macro_rules! impl_soa_ops {
+    ($($fast_ty:ident,)*) => {
+        $(
+            impl SoaOps for $fast_ty {
+                #[inline(always)]
+                fn mul_add(self, mul: Self, add: Self) -> Self {
+                    <$fast_ty>::mul_add(self, mul, add)
+                }
+
+                #[inline(always)]
+                fn rsqrt(self) -> Self {
+                    // normalization tolerates the refined approximation by construction: the
+                    // result is multiplied back into values of similar magnitude
+                    <$fast_ty>::approx_rsqrt_refined(self)
+                }
+            }
+        )*
+    };
+}
+
+impl_soa_ops! { FF32, FF64, }
+
+/// A batch of 3-component vectors stored as three contiguous component buffers.
+///
+/// The component buffers always have equal lengths. Alignment beyond the element's own is not
+/// required: the kernels use unaligned vector loads, and it is the unit stride that matters
+#[derive(Debug, Clone)]
+pub struct SoaVec3<T> {
+    x: Vec<T>,
+    y: Vec<T>,
+    z: Vec<T>,
+}
+
+impl<T: SoaOps> SoaVec3<T> {
+    /// An empty batch
+    #[inline]
+    pub fn new() -> Self {
+        SoaVec3 {
+            x: Vec::new(),
+            y: Vec::new(),
+            z: Vec::new(),
+        }
+    }
+
+    /// An empty batch with room for `capacity` vectors in each component buffer
+    #[inline]
+    pub fn with_capacity(capacity: usize) -> Self {
+        SoaVec3 {
+            x: Vec::with_capacity(capacity),
+            y: Vec::with_capacity(capacity),
+            z: Vec::with_capacity(capacity),
+        }
+    }
+
+    /// The number of vectors in the batch
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.x.len()
+    }
+
+    /// Whether the batch is empty
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.x.is_empty()
+    }
+
+    /// Append one vector to the batch
+    #[inline]
+    pub fn push(&mut self, [x, y, z]: [T; 3]) {
+        self.x.push(x);
+        self.y.push(y);
+        self.z.push(z);
+    }
+
+    /// The `x` components
+    #[inline]
+    pub fn x(&self) -> &[T] {
+        &self.x
+    }
+
+    /// The `y` components
+    #[inline]
+    pub fn y(&self) -> &[T] {
+        &self.y
+    }
+
+    /// The `z` components
+    #[inline]
+    pub fn z(&self) -> &[T] {
+        &self.z
+    }
+
+    /// Transpose an AoS buffer of `[x, y, z]` triples into SoA form
+    pub fn from_arrays(vectors: &[[T; 3]]) -> Self {
+        let mut out = Self::with_capacity(vectors.len());
+        for &v in vectors {
+            out.push(v);
+        }
+        out
+    }
+
+    /// Transpose the batch back into an AoS buffer of `[x, y, z]` triples
+    pub fn to_arrays(&self) -> Vec<[T; 3]> {
+        (0..self.len())
+            .map(|i| [self.x[i], self.y[i], self.z[i]])
+            .collect()
+    }
+
+    /// The dot product of each vector pair.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the batches have different lengths
+    pub fn dot(&self, other: &Self) -> Vec<T> {
+        assert_eq!(self.len(), other.len());
+        (0..self.len())
+            .map(|i| {
+                self.x[i].mul_add(
+                    other.x[i],
+                    self.y[i].mul_add(other.y[i], self.z[i] * other.z[i]),
+                )
+            })
+            .collect()
+    }
+
+    /// The cross product of each vector pair.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the batches have different lengths
+    pub fn cross(&self, other: &Self) -> SoaVec3<T> {
+        assert_eq!(self.len(), other.len());
+        let mut out = Self::with_capacity(self.len());
+        for i in 0..self.len() {
+            out.push([
+                self.y[i] * other.z[i] - self.z[i] * other.y[i],
+                self.z[i] * other.x[i] - self.x[i] * other.z[i],
+                self.x[i] * other.y[i] - self.y[i] * other.x[i],
+            ]);
+        }
+        out
+    }
+
+    /// The squared distance between each vector pair.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the batches have different lengths
+    pub fn distance_squared(&self, other: &Self) -> Vec<T> {
+        assert_eq!(self.len(), other.len());
+        (0..self.len())
+            .map(|i| {
+                let dx = self.x[i] - other.x[i];
+                let dy = self.y[i] - other.y[i];
+                let dz = self.z[i] - other.z[i];
+                dx.mul_add(dx, dy.mul_add(dy, dz * dz))
+            })
+            .collect()
+    }
+
+    /// Normalize every vector in place, using the refined approximate reciprocal square root
+    /// so the batch needs neither a `sqrt` nor a divide per vector.
+    ///
+    /// Zero-length vectors produce unspecified values, as dividing by zero is outside this
+    /// crate's finite-math contract
+    pub fn normalize_in_place(&mut self) {
+        for i in 0..self.len() {
+            let (x, y, z) = (self.x[i], self.y[i], self.z[i]);
+            let inv = x.mul_add(x, y.mul_add(y, z * z)).rsqrt();
+            self.x[i] = x * inv;
+            self.y[i] = y * inv;
+            self.z[i] = z * inv;
+        }
+    }
+}
+
+impl<T: SoaOps> Default for SoaVec3<T> {
+    #[inline]
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl<T: SoaOps> From<&[[T; 3]]> for SoaVec3<T> {
+    #[inline]
+    fn from(vectors: &[[T; 3]]) -> Self {
+        Self::from_arrays(vectors)
+    }
+}
+
+#[cfg(feature = "nalgebra-v029")]
+#[cfg_attr(docsrs, doc(cfg(feature = "nalgebra-v029")))]
+mod nalgebra_v029 {
+    use super::SoaVec3;
+    use crate::{FF32, FF64};
+    use ::nalgebra_v029 as na;
+
+    macro_rules! impl_point_converters {
+        ($($fast_ty:ident;)*) => {
+            $(
+                impl SoaVec3<$fast_ty> {
+                    /// Transpose a batch of points into SoA form
+                    pub fn from_points(points: &[na::Point3<$fast_ty>]) -> Self {
+                        let mut out = Self::with_capacity(points.len());
+                        for p in points {
+                            out.push([p.x, p.y, p.z]);
+                        }
+                        out
+                    }
+
+                    /// Transpose the batch back into an AoS point buffer
+                    pub fn to_points(&self) -> Vec<na::Point3<$fast_ty>> {
+                        (0..self.len())
+                            .map(|i| na::Point3::new(self.x[i], self.y[i], self.z[i]))
+                            .collect()
+                    }
+                }
+            )*
+        };
+    }
+
+    impl_point_converters! { FF32; FF64; }
+}
@@ -0,0 +1,147 @@
+use crate::poison::MaybePoison;
+use crate::{FF32, FF64};
+use core::fmt;
+
+// The wide types hold all of their lanes in a single `MaybePoison`, mirroring how the scalar
+// types wrap their primitive. Lane arithmetic is implemented in `crate::math` through the same
+// poison safe C kernels as the scalar operations; only the type definitions and the freeze
+// boundary live here.
+
+macro_rules! impl_wide {
+    ($(
+        $(#[$attr:meta])*
+        $wide_ty:ident, $fast_ty:ident, $base_ty:ident, $lanes:expr;
+     )*) => {
+        $(
+            $(#[$attr])*
+            #[derive(Clone, Copy)]
+            #[repr(transparent)]
+            pub struct $wide_ty(pub(crate) MaybePoison<[$base_ty; $lanes]>);
+
+            impl $wide_ty {
+                /// The number of lanes in this type
+                pub const LANES: usize = $lanes;
+
+                #[doc = "Create a new `"]
+                #[doc = stringify!($wide_ty)]
+                #[doc = "` instance from the given lane values."]
+                ///
+                /// The given values **MUST NOT** be infinite or NaN, and any operations involving
+                /// them must not produce infinite or NaN results in any lane. The output of any
+                /// such operation is unspecified.
+                #[inline(always)]
+                pub const fn new(lanes: [$base_ty; $lanes]) -> Self {
+                    $wide_ty(MaybePoison::new(lanes))
+                }
+
+                /// Create a new instance with every lane set to the given value.
+                ///
+                /// The value is subject to the same restrictions as [`new`](Self::new)
+                #[inline(always)]
+                pub const fn splat(value: $base_ty) -> Self {
+                    $wide_ty::new([value; $lanes])
+                }
+
+                #[doc = "Create a new instance from an array of `"]
+                #[doc = stringify!($fast_ty)]
+                #[doc = "` lanes, without freezing them."]
+                #[inline(always)]
+                pub fn from_lanes(lanes: [$fast_ty; $lanes]) -> Self {
+                    // the fast scalar is repr(transparent) over MaybePoison of the primitive, and
+                    // MaybePoison<[T; N]> has the same layout as [MaybePoison<T>; N], so this is
+                    // a plain copy of the lane bits
+                    unsafe { core::mem::transmute_copy::<[$fast_ty; $lanes], $wide_ty>(&lanes) }
+                }
+
+                #[doc = "Split this value into an array of `"]
+                #[doc = stringify!($fast_ty)]
+                #[doc = "` lanes, without freezing them."]
+                #[inline(always)]
+                pub fn to_lanes(self) -> [$fast_ty; $lanes] {
+                    unsafe { core::mem::transmute_copy::<$wide_ty, [$fast_ty; $lanes]>(&self) }
+                }
+
+                /// Freeze every lane and return the concrete primitive values.
+                ///
+                /// The base primitives are no longer in this crate's API control, so poison
+                /// propagation is stopped by freezing each lane
+                #[inline]
+                pub fn to_array(self) -> [$base_ty; $lanes] {
+                    // one vector freeze covers all lanes
+                    self.0.freeze()
+                }
+            }
+
+            impl fmt::Debug for $wide_ty {
+                fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                    <[$base_ty; $lanes] as fmt::Debug>::fmt(&self.to_array(), f)
+                }
+            }
+
+            // like the scalar comparisons, lanewise equality must freeze the operands to keep
+            // poison out of the resulting bool
+            impl PartialEq<$wide_ty> for $wide_ty {
+                #[inline]
+                fn eq(&self, other: &$wide_ty) -> bool {
+                    self.to_array() == other.to_array()
+                }
+            }
+
+            impl PartialEq<[$base_ty; $lanes]> for $wide_ty {
+                #[inline]
+                fn eq(&self, other: &[$base_ty; $lanes]) -> bool {
+                    self.to_array() == *other
+                }
+            }
+
+            impl PartialEq<$wide_ty> for [$base_ty; $lanes] {
+                #[inline]
+                fn eq(&self, other: &$wide_ty) -> bool {
+                    *self == other.to_array()
+                }
+            }
+
+            impl From<[$base_ty; $lanes]> for $wide_ty {
+                #[inline(always)]
+                fn from(from: [$base_ty; $lanes]) -> Self {
+                    <$wide_ty>::new(from)
+                }
+            }
+
+            impl From<$wide_ty> for [$base_ty; $lanes] {
+                #[inline(always)]
+                fn from(from: $wide_ty) -> Self {
+                    from.to_array()
+                }
+            }
+
+            impl From<[$fast_ty; $lanes]> for $wide_ty {
+                #[inline(always)]
+                fn from(from: [$fast_ty; $lanes]) -> Self {
+                    <$wide_ty>::from_lanes(from)
+                }
+            }
+
+            impl From<$wide_ty> for [$fast_ty; $lanes] {
+                #[inline(always)]
+                fn from(from: $wide_ty) -> Self {
+                    from.to_lanes()
+                }
+            }
+        )*
+    };
+}
+
+impl_wide! {
+    /// A 4-lane wide version of [`FF32`], applying fast-math optimizations lane by lane.
+    FF32x4, FF32, f32, 4;
+
+    /// An 8-lane wide version of [`FF32`], applying fast-math optimizations lane by lane.
+    FF32x8, FF32, f32, 8;
+
+    /// A 2-lane wide version of [`FF64`], applying fast-math optimizations lane by lane.
+    FF64x2, FF64, f64, 2;
+
+    /// A 4-lane wide version of [`FF64`], applying fast-math optimizations lane by lane.
+    FF64x4, FF64, f64, 4;
+}